@@ -7,12 +7,37 @@
 #include <vector>  // vetor de processos
 #include <map>     // Arvore rubro negra
 #include <queue>   // Fila de chegada
+#include <deque>   // Fila circular do modo online
+#include <atomic>  // Aneis lock-free do modo online
+#include <thread>  // Threads produtoras do modo online
+#include <chrono>  // Ritmo do tempo simulado em relacao ao relogio real
+#include <random>  // Gerador do sorteio da loteria
+#include <algorithm> // nth_element/sort da varredura
+#include <set>       // quanta ja avaliados na varredura
+#include <limits>    // infinito inicial da varredura
+#include <unordered_map> // pid -> indice na varredura
+#include <mutex>         // candidatos completos compartilhados na varredura
+#include <cstdint> // Campos de tamanho fixo do trace binario
+#include <cstring> // memcpy para o trace mapeado em memoria
+#include <cmath>   // exp do modelo de cache
+#include <fcntl.h>    // open do arquivo de trace
+#include <sys/mman.h> // mmap do arquivo de trace
+#include <sys/stat.h> // tamanho do arquivo de trace
+#include <unistd.h>   // ftruncate/close
+#include <dirent.h>   // listagem do diretorio do cache de resultados
+#include <utime.h>    // marca o ultimo uso de uma entrada do cache
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATISTICS_AVX2 // kernel AVX2 das estatisticas, escolhido em tempo de execucao
+#include <immintrin.h>  // Kernels AVX2 das estatisticas agregadas
+#endif
 
 // Prototipos de classes e structs
 class LotteryScheduler;
 class PriorityScheduler;
 class CFSScheduler;
 class RoundRobinScheduler;
+class EDFScheduler;
+class OnlineScheduler;
 struct CompareProcessPriority;
 struct CFSKey;
 
@@ -22,28 +47,51 @@ class Process
 {
 public:
     Process(int pid, int creation_time, int burst_time, int tickets = 0);
+    void set_io_bursts(const std::vector<int> &io_bursts); // Rajadas seguintes: E/S, CPU, E/S, CPU...
+    void set_deadline(int relative_deadline);              // Prazo relativo a criacao (-1 = sem prazo)
     int get_pid() const;
     int get_creation_time() const;
     int get_end_time() const;
-    int get_total_waiting_time() const;
+    int get_burst_time() const;          // CPU total de todas as rajadas
+    int get_io_time() const;             // E/S total
+    int get_tickets() const;             // tickets (loteria/CFS) ou prioridade
+    double get_mean_response_time() const; // media por rajada de CPU do tempo entre ficar pronto e ganhar a CPU
+    int get_deadline() const;            // prazo absoluto (-1 = sem prazo)
+    bool is_admitted() const;            // passou no teste de admissao do EDF
 
 private:
+    bool has_io_next() const;     // a rajada de CPU atual e seguida de E/S?
+    int start_io(int now);        // bloqueia ate o fim da E/S e retorna o tempo em que o processo acorda
+    void mark_running(int now);   // contabiliza o tempo de resposta da rajada atual
+
     int pid;
     int creation_time;
     int burst_time;
-    int remaining_time;
+    int remaining_time; // restante da rajada de CPU atual
     int start_time;
     int end_time;
     bool is_finished;
+    bool is_blocked; // esperando E/S
     int tickets;
     int weights;
-    int total_waiting_time;
+    std::vector<int> bursts; // CPU, E/S, CPU, E/S, ..., CPU
+    size_t burst_index;      // rajada de CPU atual
+    int io_time;
+    int ready_since;         // quando a rajada atual ficou pronta
+    bool response_pending;   // a rajada atual ainda nao ganhou a CPU
+    long long total_response_time;
+    int response_count;
+    int group;               // grupo do CFS hierarquico (0 = raiz)
+    int deadline;            // prazo absoluto para terminar (-1 = sem prazo)
+    bool admitted;           // false se o EDF recusou o prazo no teste de admissao
 
     // Public para acesso de outras classes
     friend class LotteryScheduler;
     friend class PriorityScheduler;
     friend class CFSScheduler;
     friend class RoundRobinScheduler;
+    friend class EDFScheduler;
+    friend class OnlineScheduler;
     friend struct CompareProcessPriority;
 };
 
@@ -58,13 +106,72 @@ Process::Process(int pid, int creation_time, int burst_time, int tickets)
     this->tickets = tickets;                     // usado no escalonador por loteria
     this->weights = (tickets > 0) ? tickets : 1; // valor minimo de um processo -> Me guiei pelo CFS original onde o maior peso indica a maior prioridade
     this->is_finished = false;
-    this->total_waiting_time = 0; // tempo total que o processo ficou na fila de espera
+    this->is_blocked = false;
+    this->bursts.push_back(burst_time);
+    this->burst_index = 0;
+    this->io_time = 0;
+    this->ready_since = creation_time;
+    this->response_pending = true;
+    this->total_response_time = 0;
+    this->response_count = 0;
+    this->group = 0;
+    this->deadline = -1;
+    this->admitted = true;
+}
+
+void Process::set_io_bursts(const std::vector<int> &io_bursts)
+{
+    for (size_t i = 0; i + 1 < io_bursts.size(); i += 2)
+    {
+        bursts.push_back(io_bursts[i]);     // E/S
+        bursts.push_back(io_bursts[i + 1]); // CPU
+        io_time += io_bursts[i];
+        burst_time += io_bursts[i + 1];
+    }
+}
+
+void Process::set_deadline(int relative_deadline)
+{
+    deadline = (relative_deadline >= 0) ? creation_time + relative_deadline : -1;
+}
+
+bool Process::has_io_next() const { return burst_index + 1 < bursts.size(); }
+
+int Process::start_io(int now)
+{
+    int wake_time = now + bursts[burst_index + 1];
+    burst_index += 2;
+    remaining_time = bursts[burst_index]; // proxima rajada de CPU
+    is_blocked = true;
+    ready_since = wake_time;
+    response_pending = true;
+    return wake_time;
+}
+
+void Process::mark_running(int now)
+{
+    if (start_time == -1)
+    {
+        start_time = now;
+    }
+    if (response_pending)
+    {
+        total_response_time += now - ready_since;
+        response_count++;
+        response_pending = false;
+    }
 }
+
 // Getters para acessar os atributos privados
 int Process::get_pid() const { return pid; }
 int Process::get_end_time() const { return end_time; }
 int Process::get_creation_time() const { return creation_time; }
-int Process::get_total_waiting_time() const { return total_waiting_time; }
+int Process::get_burst_time() const { return burst_time; }
+int Process::get_io_time() const { return io_time; }
+int Process::get_tickets() const { return tickets; }
+double Process::get_mean_response_time() const { return response_count > 0 ? static_cast<double>(total_response_time) / response_count : 0.0; }
+int Process::get_deadline() const { return deadline; }
+bool Process::is_admitted() const { return admitted; }
 
 // Classe para ler o arquivo de entrada e armazenar os dados dos processos
 
@@ -79,8 +186,16 @@ public:
     const std::vector<int> &get_creation_times() const; // Retorna os tempos de criação dos processos
     const std::vector<int> &get_burst_times() const;    // Retorna os tempos de execução dos processos
     const std::vector<int> &get_ticket_values() const;  // Retorna os valores de tickets dos processos
+    const std::vector<std::vector<int>> &get_io_bursts() const; // Retorna as rajadas de E/S e CPU seguintes de cada processo
+    const std::vector<std::string> &get_process_groups() const; // Retorna o grupo de cada processo ("" = raiz)
+    const std::vector<int> &get_deadlines() const;              // Retorna o prazo relativo de cada processo (-1 = sem prazo)
+    const std::vector<std::string> &get_group_names() const;    // Retorna os nomes dos grupos declarados
+    const std::vector<int> &get_group_weights() const;          // Retorna os pesos dos grupos declarados
+    const std::vector<std::string> &get_group_parents() const;  // Retorna o pai de cada grupo declarado ("" = raiz)
 
 private:
+    void parse_optional_field(const std::string &field); // Le um campo opcional chave=valor do ultimo processo lido
+
     std::string filename;
     std::string algorithm;
     int quantum;
@@ -88,6 +203,12 @@ private:
     std::vector<int> pids;           // vetores para armazenar os pids
     std::vector<int> burst_times;    // vetores para armazenar os tempos de execução
     std::vector<int> creation_times; // vetores para armazenar os tempos de criação
+    std::vector<std::vector<int>> io_bursts; // vetores para armazenar as rajadas E/S, CPU, E/S, CPU... (vazio = só CPU)
+    std::vector<std::string> process_groups; // vetores para armazenar o grupo de cada processo
+    std::vector<int> deadlines;              // vetores para armazenar os prazos relativos (-1 = sem prazo)
+    std::vector<std::string> group_names;    // vetores para armazenar os grupos (linhas grupo|nome|peso|pai)
+    std::vector<int> group_weights;
+    std::vector<std::string> group_parents;
 };
 
 FileReader::FileReader(const std::string &filename) //
@@ -118,26 +239,96 @@ void FileReader::read_file() // Lê o arquivo e armazena os dados dos processos
 
     while (std::getline(file, line)) // Lê as outras linhas do arquivo que contêm os dados dos processos
     {
+        if (line.empty() || line == "\r")
+        {
+            continue;
+        }
         std::stringstream ss(line);
         std::string token;
         int pid_val, creation_time_val, burst_time_val, ticket_value;
 
-        std::getline(ss, token, '|'); // Lê o tempo de criação do processo
+        std::getline(ss, token, '|'); // Lê o tempo de criação do processo (ou "grupo")
+        if (token == "grupo") // grupo|<nome>|<peso>[|<pai>]
+        {
+            std::string name, weight, parent;
+            std::getline(ss, name, '|');
+            std::getline(ss, weight, '|');
+            std::getline(ss, parent, '|');
+            if (!parent.empty() && parent.back() == '\r')
+            {
+                parent.pop_back();
+            }
+            group_names.push_back(name);
+            group_weights.push_back(std::stoi(weight));
+            group_parents.push_back(parent);
+            continue;
+        }
         creation_time_val = std::stoi(token);
         std::getline(ss, token, '|'); // Lê o PID do processo
         pid_val = std::stoi(token);
         std::getline(ss, token, '|'); // Lê o tempo de execução do processo
         burst_time_val = std::stoi(token);
-        std::getline(ss, token); // Lê o valor do ticket do processo
+        std::getline(ss, token, '|'); // Lê o valor do ticket do processo
         ticket_value = std::stoi(token);
 
         creation_times.push_back(creation_time_val); // Armazena o tempo de criação do processo
         pids.push_back(pid_val);                     // Armazena o PID do processo
         burst_times.push_back(burst_time_val);       // Armazena o tempo de execução do processo
         ticket_values.push_back(ticket_value);       // Armazena o valor do ticket do processo
+        io_bursts.push_back(std::vector<int>());
+        process_groups.push_back("");
+        deadlines.push_back(-1);
+
+        while (std::getline(ss, token, '|')) // Campos opcionais no formato chave=valor
+        {
+            parse_optional_field(token);
+        }
     }
     file.close();
 }
+
+void FileReader::parse_optional_field(const std::string &field)
+{
+    size_t equals = field.find('=');
+    std::string key = field.substr(0, equals);
+    std::string value = (equals == std::string::npos) ? "" : field.substr(equals + 1);
+
+    if (key == "es") // es=<E/S>,<CPU>,<E/S>,<CPU>,... depois da primeira rajada de CPU
+    {
+        std::stringstream values(value);
+        std::string item;
+        while (std::getline(values, item, ','))
+        {
+            io_bursts.back().push_back(std::stoi(item));
+        }
+        if (io_bursts.back().size() % 2 != 0)
+        {
+            std::cerr << "Rajadas de E/S do processo " << pids.back() << " devem vir em pares E/S,CPU; a ultima foi ignorada" << std::endl;
+            io_bursts.back().pop_back();
+        }
+    }
+    else if (key == "grupo") // grupo=<nome>, usado pelo CFS
+    {
+        if (!value.empty() && value.back() == '\r')
+        {
+            value.pop_back();
+        }
+        process_groups.back() = value;
+    }
+    else if (key == "prazo") // prazo=<tempo>, relativo ao tempo de criacao
+    {
+        deadlines.back() = std::stoi(value);
+        if (deadlines.back() < 0)
+        {
+            std::cerr << "Prazo negativo ignorado no processo " << pids.back() << std::endl;
+            deadlines.back() = -1;
+        }
+    }
+    else
+    {
+        std::cerr << "Campo desconhecido no processo " << pids.back() << ": " << field << std::endl;
+    }
+}
 // Getters para acessar os atributos privados
 std::string FileReader::get_algorithm() const { return algorithm; }
 int FileReader::get_quantum() const { return quantum; }
@@ -145,649 +336,3808 @@ const std::vector<int> &FileReader::get_pids() const { return pids; }
 const std::vector<int> &FileReader::get_creation_times() const { return creation_times; }
 const std::vector<int> &FileReader::get_burst_times() const { return burst_times; }
 const std::vector<int> &FileReader::get_ticket_values() const { return ticket_values; }
+const std::vector<std::vector<int>> &FileReader::get_io_bursts() const { return io_bursts; }
+const std::vector<std::string> &FileReader::get_process_groups() const { return process_groups; }
+const std::vector<int> &FileReader::get_deadlines() const { return deadlines; }
+const std::vector<std::string> &FileReader::get_group_names() const { return group_names; }
+const std::vector<int> &FileReader::get_group_weights() const { return group_weights; }
+const std::vector<std::string> &FileReader::get_group_parents() const { return group_parents; }
 
-// Escalonador por loteria
+// Registro binario de eventos de escalonamento
 
-class LotteryScheduler
+enum SliceReason // por que a fatia de CPU terminou
+{
+    REASON_PREEMPT = 0, // quantum esgotado, o processo volta para a fila
+    REASON_FINISH = 1,  // o processo terminou
+    REASON_BLOCK = 2    // o processo bloqueou em E/S
+};
+
+struct TraceRecord // registro de tamanho fixo gravado para cada fatia de CPU
+{
+    int32_t start;
+    int32_t end;
+    int32_t pid;
+    uint16_t cpu;   // o simulador tem uma unica CPU, entao e sempre 0 (reservado para varias CPUs)
+    uint8_t reason; // SliceReason
+    uint8_t reserved;
+};
+
+struct TraceHeader // cabecalho no inicio do arquivo de trace
+{
+    char magic[8]; // "ESCTRACE"
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t record_count;
+};
+
+// Recebe cada fatia de CPU emitida por um escalonador
+class EventSink
 {
 public:
-    LotteryScheduler();
-    void set_algorithm_name(const std::string &name); // Define o nome do algoritmo
-    void set_quantum(int q);                          // Define a fatia de CPU
-    void add_process(const Process &process);         // Adiciona um processo ao escalonador
-    void run();                                       // roda o escalonador
-    void print_statistics();                          // printa as estatísticas finais
+    virtual ~EventSink() {}
+    virtual void on_slice(int start, int end, int pid, int reason) = 0;
+    virtual bool should_stop() const { return false; } // true interrompe a simulacao no proximo ponto de decisao
+};
+
+// Grava os registros direto em um arquivo mapeado em memoria (somente anexando).
+// O arquivo cresce dobrando de tamanho e e truncado no tamanho exato ao fechar.
+class TraceWriter : public EventSink
+{
+public:
+    TraceWriter();
+    ~TraceWriter();
+    bool open(const std::string &filename);
+    void on_slice(int start, int end, int pid, int reason) override;
+    bool should_stop() const override { return failed; } // sem espaco para o trace a simulacao e interrompida
+    bool is_complete() const { return !failed; }
+    void close();
 
 private:
-    void update_ready_queue();          // Atualiza a fila de processos prontos
-    Process *select_winner();           // Seleciona o processo vencedor com base nos tickets
-    std::vector<Process> processes;     // vetor de processos
-    std::vector<Process *> ready_queue; // fila de processos prontos
-    std::string algorithm_name;
-    int quantum;      // fatia de CPU
-    int current_time; // tempo atual do escalonador
+    bool grow(); // dobra o tamanho do arquivo e remapeia
+    int fd;
+    char *base;      // inicio do mapeamento
+    size_t capacity; // tamanho atual do arquivo/mapeamento em bytes
+    size_t offset;   // proxima posicao livre
+    bool failed;     // nao conseguiu crescer: os registros seguintes foram perdidos
 };
 
-LotteryScheduler::LotteryScheduler() // Construtor
+TraceWriter::TraceWriter()
 {
-    quantum = 0;
-    current_time = 0;
+    fd = -1;
+    base = nullptr;
+    capacity = 0;
+    offset = 0;
+    failed = false;
 }
 
-void LotteryScheduler::set_algorithm_name(const std::string &name) { algorithm_name = name; } //
-void LotteryScheduler::set_quantum(int q) { quantum = q; }
-void LotteryScheduler::add_process(const Process &process) { processes.push_back(process); }
+TraceWriter::~TraceWriter() { close(); }
 
-void LotteryScheduler::update_ready_queue()
+bool TraceWriter::open(const std::string &filename)
 {
-    for (auto &process : processes)
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
     {
-        bool in_ready_queue = false;
-        for (const auto &ready_process : ready_queue)
-        {
-            if (ready_process->get_pid() == process.get_pid())
-            {
-                in_ready_queue = true;
-                break;
-            }
-        }
-
-        if (!process.is_finished && !in_ready_queue && process.creation_time <= current_time)
-        {
-            // A linha incorreta de cálculo de tempo de espera foi removida daqui
-            ready_queue.push_back(&process);
-        }
+        std::cerr << "Erro ao criar o arquivo de trace: " << filename << std::endl;
+        return false;
     }
+    offset = sizeof(TraceHeader);
+    return grow();
 }
 
-Process *LotteryScheduler::select_winner()
+// O mapeamento novo e criado antes de desfazer o antigo: se algo falhar, o antigo continua
+// valido e close() ainda grava o cabecalho com os registros ja escritos
+bool TraceWriter::grow()
 {
-    int total_tickets = 0;
-    for (const auto &process : ready_queue)
+    size_t new_capacity = (capacity == 0) ? (1 << 20) : capacity * 2;
+    if (ftruncate(fd, new_capacity) != 0)
     {
-        total_tickets += process->tickets;
+        std::cerr << "Erro ao aumentar o arquivo de trace" << std::endl;
+        return false;
     }
-    if (total_tickets == 0)
+    void *mapping = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
     {
-        return nullptr;
+        std::cerr << "Erro ao mapear o arquivo de trace" << std::endl;
+        return false;
     }
-    int winning_ticket = std::rand() % total_tickets;
-    int current_ticket_sum = 0;
-    for (auto &process : ready_queue)
+    if (base != nullptr)
     {
-        current_ticket_sum += process->tickets;
-        if (winning_ticket < current_ticket_sum)
-        {
-            return process;
-        }
+        munmap(base, capacity);
     }
-    return nullptr;
+    base = static_cast<char *>(mapping);
+    capacity = new_capacity;
+    return true;
 }
 
-void LotteryScheduler::run()
+void TraceWriter::on_slice(int start, int end, int pid, int reason)
 {
-    std::srand(time(0)); // semente aleatória
-
-    std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
-    std::cout << "Algoritmo: " << algorithm_name << " | Fatia de CPU: " << quantum << std::endl
-              << std::endl;
-
-    while (true) // loop do escalonador
+    if (failed)
     {
-        update_ready_queue(); // Atualiza a fila de processos prontos
-
-        bool all_finished = true;
-        for (const auto &process : processes) // percorre todos os processos e verifica se todos estão finalizados
-        {
-            if (!process.is_finished)
-            {
-                all_finished = false;
-                break;
-            }
-        }
-        if (all_finished) // se todos os processos estão finalizados, encerra a simulação
-        {
-            std::cout << "\n--- Simulacao finalizada no tempo " << current_time << " ---\n";
-            break;
-        }
-
-        if (ready_queue.empty()) // se a fila de processos prontos está vazia, incrementa o tempo atual
-        {
-            current_time++;
-            continue;
-        }
-
-        Process *winner = select_winner(); // Seleciona o processo vencedor com base nos tickets
-        if (winner == nullptr)
-        {
-            current_time++;
-            continue;
-        }
-        if (winner->start_time == -1) // Se o processo vencedor ainda não começou, define o tempo de início
-        {
-            winner->start_time = current_time;
-        }
-
-        int time_to_run = std::min(winner->remaining_time, quantum); // Calcula o tempo que o processo vencedor vai rodar na CPU
+        return;
+    }
+    if (offset + sizeof(TraceRecord) > capacity && !grow())
+    {
+        std::cerr << "Trace incompleto: a simulacao sera interrompida" << std::endl;
+        failed = true;
+        return;
+    }
+    TraceRecord rec = {start, end, pid, 0, static_cast<uint8_t>(reason), 0};
+    std::memcpy(base + offset, &rec, sizeof(rec));
+    offset += sizeof(rec);
+}
 
-        std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + time_to_run << "]: "
-                  << "Processo " << winner->get_pid() << " esta na CPU. (Restante: "
-                  << winner->remaining_time - time_to_run << ")" << std::endl;
+void TraceWriter::close()
+{
+    if (fd < 0)
+    {
+        return;
+    }
+    if (base != nullptr)
+    {
+        TraceHeader header = {{'E', 'S', 'C', 'T', 'R', 'A', 'C', 'E'}, 1, sizeof(TraceRecord), (offset - sizeof(TraceHeader)) / sizeof(TraceRecord)};
+        std::memcpy(base, &header, sizeof(header));
+        munmap(base, capacity);
+        base = nullptr;
+    }
+    if (ftruncate(fd, offset) != 0)
+    {
+        std::cerr << "Erro ao truncar o arquivo de trace" << std::endl;
+    }
+    ::close(fd);
+    fd = -1;
+}
 
-        // O bloco incorreto de cálculo de tempo de espera foi removido daqui
+// Converte um trace binario para o formato JSON do Chrome trace (abre no Perfetto e no chrome://tracing).
+// Cada unidade de tempo simulado vira 1 ms na linha do tempo.
+bool export_chrome_trace(const std::string &input, const std::string &output)
+{
+    int fd = ::open(input.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Erro ao abrir o arquivo de trace: " << input << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(TraceHeader))
+    {
+        std::cerr << "Arquivo de trace invalido: " << input << std::endl;
+        ::close(fd);
+        return false;
+    }
+    void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        std::cerr << "Erro ao mapear o arquivo de trace: " << input << std::endl;
+        return false;
+    }
 
-        current_time += time_to_run;
-        winner->remaining_time -= time_to_run; // Atualiza o tempo restante do processo vencedor
+    const char *data = static_cast<const char *>(mapping);
+    TraceHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, "ESCTRACE", 8) != 0 || header.record_size != sizeof(TraceRecord) ||
+        sizeof(TraceHeader) + header.record_count * sizeof(TraceRecord) > static_cast<size_t>(info.st_size))
+    {
+        std::cerr << "Arquivo de trace invalido: " << input << std::endl;
+        munmap(mapping, info.st_size);
+        return false;
+    }
 
-        if (winner->remaining_time <= 0) // Se o processo vencedor terminou, marca como finalizado e remove da fila de prontos
-        {
-            winner->is_finished = true;
-            winner->end_time = current_time;
-            std::cout << ">>> Processo " << winner->get_pid() << " finalizado no tempo " << current_time << " <<<" << std::endl;
+    std::ofstream out(output);
+    if (!out.is_open())
+    {
+        std::cerr << "Erro ao criar o arquivo: " << output << std::endl;
+        munmap(mapping, info.st_size);
+        return false;
+    }
 
-            for (size_t i = 0; i < ready_queue.size(); ++i)
-            {
-                if (ready_queue[i]->get_pid() == winner->get_pid())
-                {
-                    ready_queue.erase(ready_queue.begin() + i);
-                    break;
-                }
-            }
-        }
+    static const char *reason_names[] = {"preempcao", "fim", "bloqueio"};
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Simulador\"}}";
+    const TraceRecord *records = reinterpret_cast<const TraceRecord *>(data + sizeof(TraceHeader));
+    for (uint64_t i = 0; i < header.record_count; ++i)
+    {
+        const TraceRecord &rec = records[i];
+        const char *reason = (rec.reason <= REASON_BLOCK) ? reason_names[rec.reason] : "?";
+        out << ",\n{\"name\":\"Processo " << rec.pid << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << rec.cpu
+            << ",\"ts\":" << static_cast<long long>(rec.start) * 1000 << ",\"dur\":" << static_cast<long long>(rec.end - rec.start) * 1000
+            << ",\"args\":{\"pid\":" << rec.pid << ",\"motivo\":\"" << reason << "\"}}";
     }
+    out << "\n]}\n";
+    munmap(mapping, info.st_size);
+
+    std::cout << header.record_count << " eventos exportados para " << output << std::endl;
+    return true;
 }
 
-void LotteryScheduler::print_statistics()
+// Roda de temporizacao hierarquica onde os processos bloqueados em E/S esperam para acordar.
+// Sao 4 niveis de 64 posicoes: o nivel L guarda quem acorda daqui a menos de 64^(L+1) unidades
+// e e redistribuido para os niveis de baixo quando o tempo chega na sua posicao, entao dormir
+// e acordar custam O(1) por processo. Enquanto os niveis de baixo estao vazios o avanco pula
+// direto para a proxima fronteira do primeiro nivel ocupado, em vez de andar de um em um.
+template <typename T>
+class TimingWheel
 {
-    std::cout << "\n--- Estatisticas Finais ---\n";
-    std::cout << std::left << std::setw(10) << "PID"
-              << std::setw(25) << "Tempo Total"
-              << std::setw(25) << "Tempo Pronto" << std::endl;
-    std::cout << "------------------------------------------------------------\n";
+public:
+    TimingWheel();
+    void insert(int wake_time, const T &value);
+    void advance(int to, std::vector<T> &woken); // acorda, em ordem de tempo, todos com wake_time <= to
+    int next_wake() const;                       // menor wake_time pendente (INT_MAX se vazia)
+    bool empty() const;
 
-    for (const auto &process : processes)
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    struct Entry
     {
-        int turnaround_time = process.get_end_time() - process.get_creation_time(); // tempo total de existencia do processo
-        // CORREÇÃO APLICADA AQUI
-        int waiting_time = turnaround_time - process.burst_time;
+        int wake_time;
+        T value;
+    };
+    void place(const Entry &entry);
+    void cascade(std::vector<Entry> &slot, int level); // redistribui uma posicao em relacao ao tempo atual
 
-        std::cout << std::left << std::setw(10) << process.get_pid()
-                  << std::setw(25) << turnaround_time
-                  << std::setw(25) << waiting_time << std::endl;
+    std::vector<Entry> slots[LEVELS][SLOTS];
+    std::vector<Entry> overflow; // acorda alem do alcance do ultimo nivel
+    std::vector<Entry> due;      // inseridos com o tempo de acordar ja vencido
+    size_t level_count[LEVELS];  // entradas em cada nivel
+    int now;
+    size_t count;
+};
+
+template <typename T>
+TimingWheel<T>::TimingWheel()
+{
+    now = 0;
+    count = 0;
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        level_count[level] = 0;
     }
 }
 
-// Escalonador por prioridade
+template <typename T>
+bool TimingWheel<T>::empty() const { return count == 0; }
 
-struct CompareProcessPriority // struct para comparar processos
+template <typename T>
+void TimingWheel<T>::insert(int wake_time, const T &value)
 {
-    bool operator()(const Process &a, const Process &b) const
+    Entry entry = {wake_time, value};
+    place(entry);
+    count++;
+}
+
+template <typename T>
+void TimingWheel<T>::place(const Entry &entry)
+{
+    long long delta = static_cast<long long>(entry.wake_time) - now;
+    if (delta <= 0)
     {
-        if (a.weights != b.weights)
+        due.push_back(entry);
+        return;
+    }
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        if (delta < (1LL << (SLOT_BITS * (level + 1))))
         {
-            return a.weights < b.weights;
+            slots[level][(entry.wake_time >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(entry);
+            level_count[level]++;
+            return;
         }
-        return a.creation_time > b.creation_time;
     }
-};
+    overflow.push_back(entry);
+}
 
-class PriorityScheduler // Classe do escalonador por prioridade
+template <typename T>
+void TimingWheel<T>::cascade(std::vector<Entry> &slot, int level)
 {
-private:
-    std::vector<Process> ready_queue;       // Fila de processos prontos
-    std::vector<Process> pending_processes; // Fila de processos pendentes
-    std::vector<Process> finalizados;       // Fila de processos finalizados
-    int current_time = 0;
-    int quantum;                       // Fatia de CPU
-    CompareProcessPriority comparator; // Comparador de processos por prioridade
-
-    void manual_swap(Process &a, Process &b) // Função para trocar dois processos
+    std::vector<Entry> entries;
+    entries.swap(slot);
+    if (level < LEVELS) // o transbordo nao entra na contagem dos niveis
     {
-        Process temp = a;
-        a = b;
-        b = temp;
+        level_count[level] -= entries.size();
+    }
+    for (const auto &entry : entries)
+    {
+        place(entry);
     }
+}
 
-    void merge(std::vector<Process> &processes, int left, int mid, int right) // Função para mesclar dois subarrays
+template <typename T>
+void TimingWheel<T>::advance(int to, std::vector<T> &woken)
+{
+    for (const auto &entry : due)
     {
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
+        woken.push_back(entry.value);
+    }
+    count -= due.size();
+    due.clear();
 
-        std::vector<Process> L, R;
-        L.reserve(n1);
-        R.reserve(n2);
+    while (now < to)
+    {
+        if (count == 0) // nada dormindo: pula direto
+        {
+            now = to;
+            break;
+        }
 
-        for (int i = 0; i < n1; i++)
+        // Com os niveis abaixo de L vazios nada acorda nem desce antes da proxima fronteira de L
+        int lowest = 0;
+        while (lowest < LEVELS && level_count[lowest] == 0)
         {
-            L.push_back(processes[left + i]);
+            lowest++;
         }
-        for (int j = 0; j < n2; j++)
+        if (lowest > 0)
         {
-            R.push_back(processes[mid + 1 + j]);
+            long long boundary = ((static_cast<long long>(now) >> (SLOT_BITS * lowest)) + 1) << (SLOT_BITS * lowest);
+            now = static_cast<int>(std::min(boundary, static_cast<long long>(to)) - 1);
         }
+        now++;
 
-        int i = 0, j = 0;
-        int k = left;
-        while (i < n1 && j < n2)
+        // Nas fronteiras de cada nivel, a posicao correspondente desce para os niveis de baixo
+        if ((now & ((1 << (SLOT_BITS * LEVELS)) - 1)) == 0)
         {
-            if (L[i].creation_time <= R[j].creation_time)
+            cascade(overflow, LEVELS);
+        }
+        for (int level = LEVELS - 1; level >= 1; --level)
+        {
+            if ((now & ((1 << (SLOT_BITS * level)) - 1)) == 0)
             {
-                processes[k++] = L[i++];
+                cascade(slots[level][(now >> (SLOT_BITS * level)) & (SLOTS - 1)], level);
             }
-            else
+        }
+
+        std::vector<Entry> &slot = slots[0][now & (SLOTS - 1)];
+        for (const auto &entry : due) // redistribuidos que vencem exatamente agora
+        {
+            woken.push_back(entry.value);
+        }
+        for (const auto &entry : slot)
+        {
+            woken.push_back(entry.value);
+        }
+        count -= due.size() + slot.size();
+        level_count[0] -= slot.size();
+        due.clear();
+        slot.clear();
+    }
+}
+
+template <typename T>
+int TimingWheel<T>::next_wake() const
+{
+    int next = std::numeric_limits<int>::max();
+    for (const auto &entry : due)
+    {
+        next = std::min(next, entry.wake_time);
+    }
+    // Em cada nivel as posicoes ocupadas estao em ordem circular a partir da posicao atual,
+    // entao basta a primeira ocupada; um nivel de cima pode ter algo antes de um de baixo
+    for (int level = 0; level < LEVELS; ++level)
+    {
+        if (level_count[level] == 0)
+            continue;
+        int current = (now >> (SLOT_BITS * level)) & (SLOTS - 1);
+        for (int i = 1; i <= SLOTS; ++i)
+        {
+            const std::vector<Entry> &slot = slots[level][(current + i) & (SLOTS - 1)];
+            if (slot.empty())
+                continue;
+            for (const auto &entry : slot)
+            {
+                next = std::min(next, entry.wake_time);
+            }
+            break;
+        }
+    }
+    for (const auto &entry : overflow)
+    {
+        next = std::min(next, entry.wake_time);
+    }
+    return next;
+}
+
+// Estatisticas agregadas: colunas contiguas e kernels de reducao
+
+// Colunas contiguas (estrutura de vetores) com os campos de cada processo usados nas
+// estatisticas, para que as reducoes leiam memoria sequencial em vez de pular de Process em Process.
+// Cada escalonador acrescenta uma linha quando um processo termina, entao as colunas ja estao
+// prontas na hora de imprimir e nao e preciso copiar os processos.
+struct StatisticsColumns
+{
+    std::vector<int32_t> end_times;
+    std::vector<int32_t> creation_times;
+    std::vector<int32_t> burst_times; // CPU total
+    std::vector<int32_t> io_times;
+    std::vector<int32_t> tickets;     // tickets (loteria/CFS) ou prioridade
+
+    void append(const Process &process); // processo finalizado
+};
+
+void StatisticsColumns::append(const Process &process)
+{
+    end_times.push_back(process.get_end_time());
+    creation_times.push_back(process.get_creation_time());
+    burst_times.push_back(process.get_burst_time());
+    io_times.push_back(process.get_io_time());
+    tickets.push_back(process.get_tickets());
+}
+
+struct AggregateStatistics
+{
+    long long count = 0;
+    long long total_turnaround = 0;
+    long long total_waiting = 0;
+    int min_turnaround = std::numeric_limits<int>::max();
+    int max_turnaround = std::numeric_limits<int>::min();
+    int min_waiting = std::numeric_limits<int>::max();
+    int max_waiting = std::numeric_limits<int>::min();
+    long long total_burst = 0; // CPU pedida por todos os processos
+    long long total_io = 0;
+    long long total_tickets = 0;
+    int first_creation = std::numeric_limits<int>::max();
+    int last_creation = std::numeric_limits<int>::min();
+
+    double mean_turnaround() const { return count > 0 ? static_cast<double>(total_turnaround) / count : 0.0; }
+    double mean_waiting() const { return count > 0 ? static_cast<double>(total_waiting) / count : 0.0; }
+    // CPU pedida por unidade de tempo durante a janela de chegadas (> 1 = sobrecarga).
+    // Sem janela (todos chegam juntos) a taxa nao existe.
+    bool has_arrival_window() const { return count > 0 && last_creation > first_creation; }
+    double offered_load() const { return has_arrival_window() ? static_cast<double>(total_burst) / (last_creation - first_creation) : 0.0; }
+};
+
+// Reducao escalar sobre [begin, end); tambem trata a cauda da versao AVX2
+void reduce_statistics_scalar(const StatisticsColumns &columns, size_t begin, size_t end, AggregateStatistics &stats)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        int turnaround_time = columns.end_times[i] - columns.creation_times[i];
+        int waiting_time = turnaround_time - columns.burst_times[i] - columns.io_times[i];
+        stats.total_turnaround += turnaround_time;
+        stats.total_waiting += waiting_time;
+        stats.min_turnaround = std::min(stats.min_turnaround, turnaround_time);
+        stats.max_turnaround = std::max(stats.max_turnaround, turnaround_time);
+        stats.min_waiting = std::min(stats.min_waiting, waiting_time);
+        stats.max_waiting = std::max(stats.max_waiting, waiting_time);
+        stats.total_burst += columns.burst_times[i];
+        stats.total_io += columns.io_times[i];
+        stats.total_tickets += columns.tickets[i];
+        stats.first_creation = std::min(stats.first_creation, columns.creation_times[i]);
+        stats.last_creation = std::max(stats.last_creation, columns.creation_times[i]);
+    }
+}
+
+#ifdef STATISTICS_AVX2
+// Soma os 8 inteiros de 32 bits no acumulador de 4 inteiros de 64 bits (evita estouro com milhoes de processos)
+__attribute__((target("avx2"))) static inline __m256i add_widened(__m256i accumulator, __m256i values)
+{
+    accumulator = _mm256_add_epi64(accumulator, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values)));
+    return _mm256_add_epi64(accumulator, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1)));
+}
+
+__attribute__((target("avx2"))) static inline long long horizontal_sum(__m256i accumulator)
+{
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), accumulator);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2"))) static inline int horizontal_min(__m256i values)
+{
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), values);
+    return *std::min_element(lanes, lanes + 8);
+}
+
+__attribute__((target("avx2"))) static inline int horizontal_max(__m256i values)
+{
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), values);
+    return *std::max_element(lanes, lanes + 8);
+}
+
+// Processa 8 processos por iteracao e devolve onde parou; o resto fica para a versao escalar.
+// Compilado para AVX2 mesmo sem -mavx2 e so chamado se a CPU tiver AVX2.
+__attribute__((target("avx2"))) size_t reduce_statistics_avx2(const StatisticsColumns &columns, AggregateStatistics &stats)
+{
+    size_t n = columns.end_times.size();
+    size_t i = 0;
+    __m256i sum_turnaround = _mm256_setzero_si256();
+    __m256i sum_waiting = _mm256_setzero_si256();
+    __m256i sum_burst = _mm256_setzero_si256();
+    __m256i sum_io = _mm256_setzero_si256();
+    __m256i sum_tickets = _mm256_setzero_si256();
+    __m256i min_turnaround = _mm256_set1_epi32(std::numeric_limits<int>::max());
+    __m256i max_turnaround = _mm256_set1_epi32(std::numeric_limits<int>::min());
+    __m256i min_waiting = min_turnaround;
+    __m256i max_waiting = max_turnaround;
+    __m256i first_creation = min_turnaround;
+    __m256i last_creation = max_turnaround;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i end = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&columns.end_times[i]));
+        __m256i creation = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&columns.creation_times[i]));
+        __m256i burst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&columns.burst_times[i]));
+        __m256i io = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&columns.io_times[i]));
+        __m256i tickets = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&columns.tickets[i]));
+
+        __m256i turnaround = _mm256_sub_epi32(end, creation);
+        __m256i waiting = _mm256_sub_epi32(_mm256_sub_epi32(turnaround, burst), io);
+
+        sum_turnaround = add_widened(sum_turnaround, turnaround);
+        sum_waiting = add_widened(sum_waiting, waiting);
+        sum_burst = add_widened(sum_burst, burst);
+        sum_io = add_widened(sum_io, io);
+        sum_tickets = add_widened(sum_tickets, tickets);
+        min_turnaround = _mm256_min_epi32(min_turnaround, turnaround);
+        max_turnaround = _mm256_max_epi32(max_turnaround, turnaround);
+        min_waiting = _mm256_min_epi32(min_waiting, waiting);
+        max_waiting = _mm256_max_epi32(max_waiting, waiting);
+        first_creation = _mm256_min_epi32(first_creation, creation);
+        last_creation = _mm256_max_epi32(last_creation, creation);
+    }
+
+    stats.total_turnaround = horizontal_sum(sum_turnaround);
+    stats.total_waiting = horizontal_sum(sum_waiting);
+    stats.total_burst = horizontal_sum(sum_burst);
+    stats.total_io = horizontal_sum(sum_io);
+    stats.total_tickets = horizontal_sum(sum_tickets);
+    stats.min_turnaround = horizontal_min(min_turnaround);
+    stats.max_turnaround = horizontal_max(max_turnaround);
+    stats.min_waiting = horizontal_min(min_waiting);
+    stats.max_waiting = horizontal_max(max_waiting);
+    stats.first_creation = horizontal_min(first_creation);
+    stats.last_creation = horizontal_max(last_creation);
+    return i;
+}
+#endif
+
+// Totais, medias, minimos e maximos de todas as colunas em uma unica passada.
+// Em CPUs com AVX2 (verificado em tempo de execucao) usa o kernel vetorial.
+AggregateStatistics reduce_statistics(const StatisticsColumns &columns)
+{
+    AggregateStatistics stats;
+    size_t n = columns.end_times.size();
+    stats.count = static_cast<long long>(n);
+    size_t i = 0;
+
+#ifdef STATISTICS_AVX2
+    if (n >= 8 && __builtin_cpu_supports("avx2"))
+        i = reduce_statistics_avx2(columns, stats);
+#endif
+
+    reduce_statistics_scalar(columns, i, n, stats);
+    return stats;
+}
+
+// Custo de troca de contexto
+
+// Parametros do modelo de custo (tudo zero = trocas gratuitas)
+struct SwitchCostModel
+{
+    int switch_cost = 0;      // custo fixo de cada troca entre processos diferentes
+    int cache_penalty = 0;    // penalidade maxima de cache fria ao retomar um processo
+    double cache_decay = 0.0; // tau: trabalho de outros processos ate a cache esfriar (0 = esfria de imediato)
+
+    bool enabled() const { return switch_cost > 0 || cache_penalty > 0; }
+};
+
+// Cobra em tempo simulado o custo de cada troca de contexto. Quando um processo volta a CPU
+// depois que outros executaram W unidades, a cache dele ja esfriou em parte e a penalidade e
+// P * (1 - e^(-W / tau)): quanto mais trabalho alheio no meio, mais perto de P.
+class SwitchCostTracker
+{
+public:
+    void set_model(const SwitchCostModel &m) { model = m; }
+    int dispatch(int pid, int now, bool verbose); // retorna o custo a cobrar antes de pid executar
+    void ran(int pid, int slice);                 // pid executou slice unidades
+    void print_statistics(long long finished, int end_time) const;
+
+private:
+    SwitchCostModel model;
+    std::unordered_map<int, long long> last_work; // total_work no fim da ultima fatia de cada processo
+    long long total_work = 0;                     // CPU executada por todos os processos ate agora
+    int last_pid = -1;
+    long long switch_count = 0;
+    long long switch_time = 0;
+    long long cache_time = 0;
+};
+
+int SwitchCostTracker::dispatch(int pid, int now, bool verbose)
+{
+    if (last_pid == -1 || pid == last_pid)
+    {
+        return 0;
+    }
+    switch_count++;
+    int cache_cost = 0;
+    if (model.cache_penalty > 0)
+    {
+        auto it = last_work.find(pid);
+        long long intervening_work = (it != last_work.end()) ? total_work - it->second : 0; // processo novo ainda nao tem cache para perder
+        if (intervening_work > 0)
+        {
+            double cooled = (model.cache_decay > 0.0) ? 1.0 - std::exp(-intervening_work / model.cache_decay) : 1.0;
+            cache_cost = static_cast<int>(std::lround(model.cache_penalty * cooled));
+        }
+    }
+    switch_time += model.switch_cost;
+    cache_time += cache_cost;
+
+    int cost = model.switch_cost + cache_cost;
+    if (verbose && cost > 0)
+    {
+        std::cout << "Tempo[" << std::setw(3) << now << " -> " << std::setw(3) << now + cost << "]: Troca de contexto para o processo "
+                  << pid << " (troca " << model.switch_cost << ", cache " << cache_cost << ")" << std::endl;
+    }
+    return cost;
+}
+
+void SwitchCostTracker::ran(int pid, int slice)
+{
+    total_work += slice;
+    if (model.cache_penalty > 0)
+    {
+        last_work[pid] = total_work;
+    }
+    last_pid = pid;
+}
+
+void SwitchCostTracker::print_statistics(long long finished, int end_time) const
+{
+    if (!model.enabled())
+    {
+        return;
+    }
+    long long overhead = switch_time + cache_time;
+    std::cout << "Trocas de contexto: " << switch_count << " | Tempo em trocas: " << switch_time
+              << " | Penalidade de cache: " << cache_time << " | Sobrecarga: " << std::fixed << std::setprecision(2)
+              << (end_time > 0 ? 100.0 * overhead / end_time : 0.0) << "%" << std::endl;
+    std::cout << "Vazao: " << std::setprecision(4) << (end_time > 0 ? static_cast<double>(finished) / end_time : 0.0)
+              << " processos por unidade de tempo" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Atraso (fim - prazo) de cada processo com prazo e a taxa de prazos perdidos.
+// Nao imprime nada se nenhum processo tiver prazo; per_process = false imprime so o resumo.
+void print_deadline_table(const std::vector<Process> &processes, bool per_process = true)
+{
+    int with_deadline = 0;
+    int missed = 0;
+    int rejected = 0;
+    int max_lateness = std::numeric_limits<int>::min();
+    for (const auto &process : processes)
+    {
+        if (process.get_deadline() < 0)
+        {
+            continue;
+        }
+        if (with_deadline == 0)
+        {
+            std::cout << "\n--- Prazos ---\n";
+        }
+        if (with_deadline == 0 && per_process)
+        {
+            std::cout << std::left << std::setw(10) << "PID"
+                      << std::setw(15) << "Prazo"
+                      << std::setw(15) << "Atraso"
+                      << "Situacao" << std::endl;
+            std::cout << "--------------------------------------------------\n";
+        }
+        int lateness = process.get_end_time() - process.get_deadline(); // negativo = terminou antes do prazo
+        with_deadline++;
+        missed += (lateness > 0);
+        rejected += !process.is_admitted();
+        max_lateness = std::max(max_lateness, lateness);
+        if (!per_process)
+        {
+            continue;
+        }
+
+        std::cout << std::left << std::setw(10) << process.get_pid()
+                  << std::setw(15) << process.get_deadline()
+                  << std::setw(15) << lateness
+                  << (lateness > 0 ? "perdido" : "cumprido")
+                  << (process.is_admitted() ? "" : " (nao admitido)") << std::endl;
+    }
+    if (with_deadline == 0)
+    {
+        return;
+    }
+
+    std::cout << (per_process ? "\n" : "") << "Prazos perdidos: " << missed << "/" << with_deadline << " ("
+              << std::fixed << std::setprecision(2) << 100.0 * missed / with_deadline << "%)"
+              << " | Atraso maximo: " << max_lateness << std::endl;
+    if (rejected > 0)
+    {
+        std::cout << "Nao admitidos pelo teste de densidade: " << rejected << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Tabela de estatisticas finais comum a todos os escalonadores.
+// Os agregados vem de reduce_statistics sobre as colunas dos processos finalizados; a tabela
+// por processo e so impressao e pode ser omitida.
+void print_statistics_table(const std::vector<Process> &processes, const StatisticsColumns &columns, int end_time,
+                            bool per_process = true, const SwitchCostTracker *switch_costs = nullptr)
+{
+    std::cout << "\n--- Estatisticas Finais ---\n";
+    if (per_process)
+    {
+        std::cout << std::left << std::setw(10) << "PID"
+                  << std::setw(25) << "Tempo Total"
+                  << std::setw(25) << "Tempo Pronto"
+                  << std::setw(25) << "Resposta Media" << std::endl;
+        std::cout << "-------------------------------------------------------------------------------\n";
+
+        for (const auto &process : processes)
+        {
+            int turnaround_time = process.get_end_time() - process.get_creation_time(); // tempo total de existencia do processo
+            int waiting_time = turnaround_time - process.get_burst_time() - process.get_io_time(); // E/S nao conta como espera na fila
+
+            std::cout << std::left << std::setw(10) << process.get_pid()
+                      << std::setw(25) << turnaround_time
+                      << std::setw(25) << waiting_time
+                      << std::setw(25) << process.get_mean_response_time() << std::endl;
+        }
+    }
+
+    AggregateStatistics stats = reduce_statistics(columns);
+    double utilization = (end_time > 0) ? 100.0 * stats.total_burst / end_time : 0.0;
+    std::cout << "\nUtilizacao da CPU: " << stats.total_burst << "/" << end_time << " ("
+              << std::fixed << std::setprecision(2) << utilization << "%)" << std::endl;
+    if (stats.count > 0)
+    {
+        std::cout << "Processos: " << stats.count
+                  << " | Tempo total medio: " << stats.mean_turnaround() << " (min " << stats.min_turnaround << ", max " << stats.max_turnaround << ")"
+                  << " | Tempo pronto medio: " << stats.mean_waiting() << " (min " << stats.min_waiting << ", max " << stats.max_waiting << ")" << std::endl;
+        std::cout << "Carga: CPU " << stats.total_burst << " | E/S " << stats.total_io << " | Tickets/prioridade " << stats.total_tickets
+                  << " | Carga oferecida: ";
+        if (stats.has_arrival_window())
+            std::cout << stats.offered_load() << std::endl;
+        else
+            std::cout << "- (todos chegam juntos)" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+    if (switch_costs)
+    {
+        switch_costs->print_statistics(stats.count, end_time);
+    }
+
+    print_deadline_table(processes, per_process);
+}
+
+// Escalonador por loteria
+
+class LotteryScheduler
+{
+public:
+    LotteryScheduler();
+    void set_algorithm_name(const std::string &name); // Define o nome do algoritmo
+    void set_quantum(int q);                          // Define a fatia de CPU
+    void set_seed(unsigned seed);                     // Fixa a semente do sorteio (padrao: relogio)
+    void set_event_sink(EventSink *s);                // Recebe cada fatia (trace, varredura)
+    void set_verbose(bool v);                         // Liga/desliga o log de fatias
+    void set_switch_cost_model(const SwitchCostModel &model); // Custo das trocas de contexto
+    void add_process(const Process &process);         // Adiciona um processo ao escalonador
+    void run();                                       // roda o escalonador
+    void print_statistics(bool per_process = true);   // printa as estatísticas finais
+
+private:
+    void update_ready_queue();          // Atualiza a fila de processos prontos
+    void wake_processes();              // Libera os processos cuja E/S terminou
+    Process *select_winner();           // Seleciona o processo vencedor com base nos tickets
+    std::vector<Process> processes;     // vetor de processos
+    std::vector<Process *> ready_queue; // fila de processos prontos
+    StatisticsColumns statistics;       // colunas dos processos finalizados
+    TimingWheel<Process *> sleeping;    // processos bloqueados em E/S
+    std::string algorithm_name;
+    int quantum;         // fatia de CPU
+    int current_time;    // tempo atual do escalonador
+    EventSink *sink;     // recebe as fatias (opcional)
+    bool verbose;        // imprime o log da simulacao
+    bool has_seed;       // semente definida por set_seed
+    std::mt19937 rng;    // gerador do sorteio, um por escalonador para permitir simulacoes em paralelo
+    SwitchCostTracker switch_costs; // custo das trocas de contexto
+};
+
+LotteryScheduler::LotteryScheduler() // Construtor
+{
+    quantum = 0;
+    current_time = 0;
+    sink = nullptr;
+    verbose = true;
+    has_seed = false;
+}
+
+void LotteryScheduler::set_algorithm_name(const std::string &name) { algorithm_name = name; } //
+void LotteryScheduler::set_quantum(int q) { quantum = q; }
+void LotteryScheduler::set_event_sink(EventSink *s) { sink = s; }
+void LotteryScheduler::set_seed(unsigned seed)
+{
+    rng.seed(seed);
+    has_seed = true;
+}
+void LotteryScheduler::set_verbose(bool v) { verbose = v; }
+void LotteryScheduler::set_switch_cost_model(const SwitchCostModel &model) { switch_costs.set_model(model); }
+void LotteryScheduler::add_process(const Process &process) { processes.push_back(process); }
+
+void LotteryScheduler::update_ready_queue()
+{
+    for (auto &process : processes)
+    {
+        bool in_ready_queue = false;
+        for (const auto &ready_process : ready_queue)
+        {
+            if (ready_process->get_pid() == process.get_pid())
+            {
+                in_ready_queue = true;
+                break;
+            }
+        }
+
+        if (!process.is_finished && !process.is_blocked && !in_ready_queue && process.creation_time <= current_time)
+        {
+            // A linha incorreta de cálculo de tempo de espera foi removida daqui
+            ready_queue.push_back(&process);
+        }
+    }
+}
+
+void LotteryScheduler::wake_processes()
+{
+    std::vector<Process *> woken;
+    sleeping.advance(current_time, woken);
+    for (auto &process : woken)
+    {
+        process->is_blocked = false; // volta a concorrer no proximo update_ready_queue
+    }
+}
+
+Process *LotteryScheduler::select_winner()
+{
+    int total_tickets = 0;
+    for (const auto &process : ready_queue)
+    {
+        total_tickets += process->tickets;
+    }
+    if (total_tickets == 0)
+    {
+        return nullptr;
+    }
+    int winning_ticket = rng() % total_tickets;
+    int current_ticket_sum = 0;
+    for (auto &process : ready_queue)
+    {
+        current_ticket_sum += process->tickets;
+        if (winning_ticket < current_ticket_sum)
+        {
+            return process;
+        }
+    }
+    return nullptr;
+}
+
+void LotteryScheduler::run()
+{
+    if (!has_seed)
+    {
+        rng.seed(time(0)); // semente aleatória
+    }
+
+    if (verbose)
+    {
+        std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
+        std::cout << "Algoritmo: " << algorithm_name << " | Fatia de CPU: " << quantum << std::endl
+                  << std::endl;
+    }
+
+    while (true) // loop do escalonador
+    {
+        if (sink && sink->should_stop()) // o observador pediu para abandonar a simulacao
+        {
+            break;
+        }
+        wake_processes();
+        update_ready_queue(); // Atualiza a fila de processos prontos
+
+        bool all_finished = true;
+        for (const auto &process : processes) // percorre todos os processos e verifica se todos estão finalizados
+        {
+            if (!process.is_finished)
+            {
+                all_finished = false;
+                break;
+            }
+        }
+        if (all_finished) // se todos os processos estão finalizados, encerra a simulação
+        {
+            if (verbose)
+                std::cout << "\n--- Simulacao finalizada no tempo " << current_time << " ---\n";
+            break;
+        }
+
+        if (ready_queue.empty()) // se a fila de processos prontos está vazia, incrementa o tempo atual
+        {
+            current_time++;
+            continue;
+        }
+
+        Process *winner = select_winner(); // Seleciona o processo vencedor com base nos tickets
+        if (winner == nullptr)
+        {
+            current_time++;
+            continue;
+        }
+        current_time += switch_costs.dispatch(winner->get_pid(), current_time, verbose); // Custo da troca de contexto, se houver
+        winner->mark_running(current_time); // Define o tempo de início e contabiliza o tempo de resposta da rajada
+
+        int time_to_run = std::min(winner->remaining_time, quantum); // Calcula o tempo que o processo vencedor vai rodar na CPU
+
+        if (verbose)
+        {
+            std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + time_to_run << "]: "
+                      << "Processo " << winner->get_pid() << " esta na CPU. (Restante: "
+                      << winner->remaining_time - time_to_run << ")" << std::endl;
+        }
+
+        // O bloco incorreto de cálculo de tempo de espera foi removido daqui
+
+        current_time += time_to_run;
+        winner->remaining_time -= time_to_run; // Atualiza o tempo restante do processo vencedor
+        switch_costs.ran(winner->get_pid(), time_to_run);
+
+        if (sink)
+        {
+            int reason = (winner->remaining_time > 0) ? REASON_PREEMPT : (winner->has_io_next() ? REASON_BLOCK : REASON_FINISH);
+            sink->on_slice(current_time - time_to_run, current_time, winner->get_pid(), reason);
+        }
+
+        if (winner->remaining_time <= 0) // Se a rajada terminou, o processo bloqueia em E/S ou finaliza; nos dois casos sai da fila de prontos
+        {
+            if (winner->has_io_next())
+            {
+                int wake_time = winner->start_io(current_time);
+                sleeping.insert(wake_time, winner);
+                if (verbose)
+                    std::cout << ">>> Processo " << winner->get_pid() << " bloqueado em E/S ate o tempo " << wake_time << " <<<" << std::endl;
+            }
+            else
+            {
+                winner->is_finished = true;
+                winner->end_time = current_time;
+                statistics.append(*winner);
+                if (verbose)
+                    std::cout << ">>> Processo " << winner->get_pid() << " finalizado no tempo " << current_time << " <<<" << std::endl;
+            }
+
+            for (size_t i = 0; i < ready_queue.size(); ++i)
+            {
+                if (ready_queue[i]->get_pid() == winner->get_pid())
+                {
+                    ready_queue.erase(ready_queue.begin() + i);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void LotteryScheduler::print_statistics(bool per_process)
+{
+    print_statistics_table(processes, statistics, current_time, per_process, &switch_costs);
+}
+
+// Escalonador por prioridade
+
+struct CompareProcessPriority // struct para comparar processos
+{
+    bool operator()(const Process &a, const Process &b) const
+    {
+        if (a.weights != b.weights)
+        {
+            return a.weights < b.weights;
+        }
+        return a.creation_time > b.creation_time;
+    }
+};
+
+class PriorityScheduler // Classe do escalonador por prioridade
+{
+private:
+    std::vector<Process> ready_queue;       // Fila de processos prontos
+    std::vector<Process> pending_processes; // Fila de processos pendentes
+    std::vector<Process> finalizados;       // Fila de processos finalizados
+    StatisticsColumns statistics;           // Colunas dos processos finalizados
+    TimingWheel<Process> sleeping;          // Processos bloqueados em E/S
+    int current_time = 0;
+    int quantum;                       // Fatia de CPU
+    CompareProcessPriority comparator; // Comparador de processos por prioridade
+    EventSink *sink = nullptr;         // Recebe as fatias (opcional)
+    bool verbose = true;               // Imprime o log de fatias
+    SwitchCostTracker switch_costs;    // Custo das trocas de contexto
+
+    void manual_swap(Process &a, Process &b) // Função para trocar dois processos
+    {
+        Process temp = a;
+        a = b;
+        b = temp;
+    }
+
+    void merge(std::vector<Process> &processes, int left, int mid, int right) // Função para mesclar dois subarrays
+    {
+        int n1 = mid - left + 1;
+        int n2 = right - mid;
+
+        std::vector<Process> L, R;
+        L.reserve(n1);
+        R.reserve(n2);
+
+        for (int i = 0; i < n1; i++)
+        {
+            L.push_back(processes[left + i]);
+        }
+        for (int j = 0; j < n2; j++)
+        {
+            R.push_back(processes[mid + 1 + j]);
+        }
+
+        int i = 0, j = 0;
+        int k = left;
+        while (i < n1 && j < n2)
+        {
+            if (L[i].creation_time <= R[j].creation_time)
+            {
+                processes[k++] = L[i++];
+            }
+            else
+            {
+                processes[k++] = R[j++];
+            }
+        }
+        while (i < n1)
+            processes[k++] = L[i++];
+        while (j < n2)
+            processes[k++] = R[j++];
+    }
+
+    void merge_sort(std::vector<Process> &processes, int left, int right) // Função para ordenar os processos com merge sort
+    {
+        if (left >= right)
+        {
+            return;
+        }
+
+        int mid = left + (right - left) / 2;
+
+        merge_sort(processes, left, mid);
+        merge_sort(processes, mid + 1, right);
+
+        merge(processes, left, mid, right);
+    }
+
+    void heapify_up(int index) // Função para manter a propriedade do heap ao inserir um novo processo
+    {
+        if (index == 0)
+            return;
+        int parent_index = (index - 1) / 2;
+
+        if (comparator(ready_queue[parent_index], ready_queue[index]))
+        {
+            manual_swap(ready_queue[parent_index], ready_queue[index]);
+            heapify_up(parent_index);
+        }
+    }
+    void heapify_down(int index) // Função para manter a propriedade do heap ao remover o processo de maior prioridade
+    {
+        int left_child_index = 2 * index + 1;
+        int right_child_index = 2 * index + 2;
+        int largest = index;
+
+        if (left_child_index < ready_queue.size() && comparator(ready_queue[largest], ready_queue[left_child_index]))
+        {
+            largest = left_child_index;
+        }
+        if (right_child_index < ready_queue.size() && comparator(ready_queue[largest], ready_queue[right_child_index]))
+        {
+            largest = right_child_index;
+        }
+
+        if (largest != index)
+        {
+            manual_swap(ready_queue[index], ready_queue[largest]);
+            heapify_down(largest);
+        }
+    }
+
+public:
+    PriorityScheduler(int q) : quantum(q) {} // Construtor que recebe a fatia de CPU
+    void set_event_sink(EventSink *s) { sink = s; }
+    void set_verbose(bool v) { verbose = v; }
+    void set_switch_cost_model(const SwitchCostModel &model) { switch_costs.set_model(model); }
+
+    void addProcess(int pid, int creation_time, int burst_time, int priority, const std::vector<int> &io_bursts = std::vector<int>(), int deadline = -1) // Adiciona um processo à fila de pendentes
+    {
+        pending_processes.emplace_back(pid, creation_time, burst_time, priority);
+        pending_processes.back().set_io_bursts(io_bursts);
+        pending_processes.back().set_deadline(deadline);
+    }
+
+    void run()
+    {
+        if (verbose)
+        {
+            std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
+            std::cout << "Algoritmo: prioridade | Fatia de CPU: " << quantum << std::endl
+                      << std::endl;
+        }
+
+        if (!pending_processes.empty())
+        {
+            merge_sort(pending_processes, 0, pending_processes.size() - 1);
+        }
+        while (!ready_queue.empty() || !pending_processes.empty() || !sleeping.empty())
+        {
+            if (sink && sink->should_stop())
+            {
+                break;
+            }
+
+            std::vector<Process> woken; // processos cuja E/S terminou voltam para o heap
+            sleeping.advance(current_time, woken);
+            for (auto &w : woken)
+            {
+                w.is_blocked = false;
+                ready_queue.push_back(w);
+                heapify_up(ready_queue.size() - 1);
+            }
+
+            auto it = pending_processes.begin();
+            while (it != pending_processes.end())
+            {
+                if (it->creation_time <= current_time)
+                {
+                    ready_queue.push_back(*it);
+                    heapify_up(ready_queue.size() - 1);
+
+                    it = pending_processes.erase(it);
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            if (!ready_queue.empty())
+            {
+                Process p = ready_queue.front();
+                manual_swap(ready_queue.front(), ready_queue.back());
+                ready_queue.pop_back();
+                if (!ready_queue.empty())
+                {
+                    heapify_down(0);
+                }
+                current_time += switch_costs.dispatch(p.pid, current_time, verbose);
+                p.mark_running(current_time);
+                int execution_time = (quantum < p.remaining_time) ? quantum : p.remaining_time;
+
+                if (verbose)
+                {
+                    std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + execution_time << "]: "
+                              << "Processo " << p.pid << " esta na CPU. (Restante: "
+                              << p.remaining_time - execution_time << ")" << std::endl;
+                }
+
+                current_time += execution_time;
+                p.remaining_time -= execution_time;
+                switch_costs.ran(p.pid, execution_time);
+
+                if (sink)
+                {
+                    int reason = (p.remaining_time > 0) ? REASON_PREEMPT : (p.has_io_next() ? REASON_BLOCK : REASON_FINISH);
+                    sink->on_slice(current_time - execution_time, current_time, p.pid, reason);
+                }
+
+                if (p.remaining_time > 0)
+                {
+                    ready_queue.push_back(p);
+                    heapify_up(ready_queue.size() - 1);
+                }
+                else if (p.has_io_next())
+                {
+                    int wake_time = p.start_io(current_time);
+                    if (verbose)
+                        std::cout << ">>> Processo " << p.pid << " bloqueado em E/S ate o tempo " << wake_time << " <<<" << std::endl;
+                    sleeping.insert(wake_time, p);
+                }
+                else
+                {
+                    p.end_time = current_time;
+                    statistics.append(p);
+                    if (verbose)
+                        std::cout << ">>> Processo " << p.pid << " finalizado no tempo " << current_time << " <<<" << std::endl;
+                    finalizados.push_back(p);
+                }
+            }
+            else
+            {
+                current_time++;
+            }
+        }
+    }
+
+    void print_statistics(bool per_process = true)
+    {
+        print_statistics_table(finalizados, statistics, current_time, per_process, &switch_costs);
+    }
+};
+
+// Escalonador CFS
+
+// Fornece a ordenação
+struct CFSKey
+{
+    double vruntime;
+    int pid;
+
+    bool operator<(const CFSKey &other) const
+    {
+        // compara os vruntimes
+        if (vruntime == other.vruntime)
+            return pid < other.pid; // Se os vruntimes são iguais, usa o PID como desempate
+        return vruntime < other.vruntime;
+    }
+};
+
+// Classe do Escalonador CFS
+//
+// Com grupos declarados no arquivo o escalonamento e hierarquico (como os cgroups do Linux):
+// cada grupo tem a sua propria arvore por vruntime com os processos e subgrupos prontos, e
+// aparece como uma entidade na arvore do grupo pai. A escolha desce da raiz pegando sempre a
+// entidade de menor vruntime, e a fatia executada e cobrada do processo e de cada grupo acima
+// dele (proporcional ao peso de cada um), entao cada decisao custa O(profundidade * log n).
+// Sem grupos tudo fica no grupo raiz e o comportamento e o do CFS plano.
+class CFSScheduler
+{
+private:
+    struct Sleeper // processo bloqueado em E/S, guarda o vruntime que tinha ao dormir
+    {
+        double vruntime;
+        Process proc;
+    };
+
+    struct Group
+    {
+        std::string name;
+        int weight;
+        int parent;                           // indice do grupo pai (-1 na raiz)
+        std::map<CFSKey, Process> run_queue;  // processos prontos do grupo -> usa a arvore da lib
+        std::map<CFSKey, int> children;       // subgrupos com algo pronto, ordenados pelo vruntime do subgrupo
+        double vruntime = 0.0;                // vruntime do grupo na arvore do pai
+        double min_vruntime = 0.0;            // menor vruntime ja escolhido dentro do grupo, so cresce
+        bool queued = false;                  // esta na arvore do pai
+        long long cpu_time = 0;               // CPU consumida pelo grupo e seus subgrupos
+        long long contended_cpu = 0;          // parte de cpu_time consumida com todos os irmaos prontos
+        int child_groups = 0;                 // numero de subgrupos diretos
+    };
+
+    std::vector<Group> groups;          // groups[0] e a raiz
+    std::queue<Process> arrival_queue;   // Fila de chegada
+    std::vector<Process> finished_processes;
+    StatisticsColumns statistics;        // colunas dos processos finalizados
+    TimingWheel<Sleeper> sleeping;       // processos bloqueados em E/S
+    int cpu_time = 0;
+    // define a quantidade de tempo que um processo pode rodar na cpu, apos isso ele muda -> IMPORTANTE Pode mudar mas olhe bem os arquivos nao coloque um número absurdo
+    const int TIME_SLICE;
+    // peso mínimo que um processo pode ter vai ser usado para o cálculo do vrtime
+    const int MIN_WEIGHT = 1;
+    EventSink *sink = nullptr;    // recebe as fatias (opcional)
+    bool verbose = true;          // imprime o log de fatias
+    SwitchCostTracker switch_costs; // custo das trocas de contexto
+
+    bool has_ready(const Group &group) const { return !group.run_queue.empty() || !group.children.empty(); }
+
+    // Coloca o processo na arvore do seu grupo e enfileira os grupos acima que estavam vazios
+    void enqueue(const Process &proc, double vruntime)
+    {
+        groups[proc.group].run_queue.insert({{vruntime, proc.pid}, proc});
+        for (int g = proc.group; g != 0 && !groups[g].queued; g = groups[g].parent)
+        {
+            Group &group = groups[g];
+            Group &parent = groups[group.parent];
+            // Um grupo que ficou vazio por muito tempo nao volta com credito acumulado
+            group.vruntime = std::max(group.vruntime, parent.min_vruntime - TIME_SLICE / 2.0);
+            parent.children.insert({{group.vruntime, g}, g});
+            group.queued = true;
+        }
+    }
+
+    // Desce da raiz ate o processo de menor vruntime e o retira da arvore do seu grupo
+    Process pick_next(double &vruntime)
+    {
+        int g = 0;
+        while (true)
+        {
+            Group &group = groups[g];
+            auto proc_it = group.run_queue.begin();
+            auto child_it = group.children.begin();
+            bool take_child = (proc_it == group.run_queue.end()) ||
+                              (child_it != group.children.end() && child_it->first.vruntime < proc_it->first.vruntime);
+            if (take_child)
+            {
+                group.min_vruntime = std::max(group.min_vruntime, child_it->first.vruntime);
+                g = child_it->second;
+                continue;
+            }
+            vruntime = proc_it->first.vruntime;
+            group.min_vruntime = std::max(group.min_vruntime, vruntime);
+            Process proc = proc_it->second;
+            group.run_queue.erase(proc_it);
+            return proc;
+        }
+    }
+
+    // Cobra a fatia de cada grupo acima do processo e reposiciona (ou retira) o grupo na arvore do pai
+    void charge_groups(int g, int slice)
+    {
+        groups[0].cpu_time += slice;
+        for (; g != 0; g = groups[g].parent)
+        {
+            Group &group = groups[g];
+            Group &parent = groups[group.parent];
+            group.cpu_time += slice;
+            // O grupo ainda esta na arvore do pai, entao ela tem todos os irmaos se todos disputam a CPU
+            if (parent.children.size() == static_cast<size_t>(parent.child_groups))
+                group.contended_cpu += slice;
+            parent.children.erase({group.vruntime, g});
+            group.vruntime += (static_cast<double>(slice) * MIN_WEIGHT) / group.weight;
+            group.queued = has_ready(group);
+            if (group.queued)
+            {
+                parent.children.insert({{group.vruntime, g}, g});
+            }
+        }
+    }
+
+    bool any_ready() const { return has_ready(groups[0]); }
+
+public:
+    CFSScheduler(int time_slice) : TIME_SLICE(time_slice)
+    {
+        Group root;
+        root.name = "raiz";
+        root.weight = 1;
+        root.parent = -1;
+        groups.push_back(root);
+    }
+    void set_event_sink(EventSink *s) { sink = s; }
+    void set_verbose(bool v) { verbose = v; }
+    void set_switch_cost_model(const SwitchCostModel &model) { switch_costs.set_model(model); }
+    void load_processes(const FileReader &reader)
+    {
+        // Grupos: primeiro todos os nomes, depois os pais (um grupo pode citar um pai declarado depois)
+        const auto &group_names = reader.get_group_names();
+        const auto &group_weights = reader.get_group_weights();
+        const auto &group_parents = reader.get_group_parents();
+        std::map<std::string, int> group_index;
+        group_index["raiz"] = 0;
+        for (size_t i = 0; i < group_names.size(); ++i)
+        {
+            if (group_index.count(group_names[i]))
+            {
+                std::cerr << "Grupo repetido ignorado: " << group_names[i] << std::endl;
+                continue;
+            }
+            Group group;
+            group.name = group_names[i];
+            group.weight = std::max(group_weights[i], MIN_WEIGHT);
+            group.parent = 0;
+            group_index[group.name] = static_cast<int>(groups.size());
+            groups.push_back(group);
+        }
+        for (size_t i = 0; i < group_names.size(); ++i)
+        {
+            int g = group_index[group_names[i]];
+            if (group_parents[i].empty() || groups[g].name != group_names[i] || groups[g].parent != 0)
+                continue;
+            auto parent = group_index.find(group_parents[i]);
+            if (parent == group_index.end())
+            {
+                std::cerr << "Grupo pai desconhecido: " << group_parents[i] << " (o grupo " << group_names[i] << " fica na raiz)" << std::endl;
+                continue;
+            }
+            // Nao aceita ciclos: o novo pai nao pode descender do grupo
+            int ancestor = parent->second;
+            while (ancestor > 0 && ancestor != g)
+                ancestor = groups[ancestor].parent;
+            if (ancestor == g)
+            {
+                std::cerr << "Ciclo na hierarquia de grupos: " << group_names[i] << " fica na raiz" << std::endl;
+                continue;
+            }
+            groups[g].parent = parent->second;
+        }
+        for (size_t g = 1; g < groups.size(); ++g)
+            groups[groups[g].parent].child_groups++;
+
+        const auto &pids = reader.get_pids();
+        const auto &creation_times = reader.get_creation_times();
+        const auto &burst_times = reader.get_burst_times();
+        const auto &tickets = reader.get_ticket_values();
+        const auto &io_bursts = reader.get_io_bursts();
+        const auto &process_groups = reader.get_process_groups();
+        const auto &deadlines = reader.get_deadlines();
+
+        for (size_t i = 0; i < pids.size(); ++i)
+        {
+            Process proc(pids[i], creation_times[i], burst_times[i], tickets[i]);
+            proc.set_io_bursts(io_bursts[i]);
+            proc.set_deadline(deadlines[i]);
+            if (!process_groups[i].empty())
+            {
+                auto group = group_index.find(process_groups[i]);
+                if (group != group_index.end())
+                    proc.group = group->second;
+                else
+                    std::cerr << "Processo " << pids[i] << " cita o grupo desconhecido " << process_groups[i] << " e fica na raiz" << std::endl;
+            }
+            arrival_queue.push(proc);
+        }
+    }
+
+    void run()
+    {
+        if (verbose)
+        {
+            std::cout << "\n--- Iniciando Simulacao do Escalonador ---\n";
+            std::cout << "Algoritmo: CFS | Fatia de CPU: " << TIME_SLICE << "\n\n";
+        }
+
+        while (any_ready() || !arrival_queue.empty() || !sleeping.empty())
+        {
+            if (sink && sink->should_stop())
+            {
+                break;
+            }
+
+            // Quem acorda da E/S volta com o vruntime que tinha, mas nunca muito atras do menor vruntime
+            // atual do grupo (no maximo meia fatia de credito), senao um processo que dormiu muito monopolizaria a CPU
+            std::vector<Sleeper> woken;
+            sleeping.advance(cpu_time, woken);
+            for (auto &w : woken)
+            {
+                double vruntime = std::max(w.vruntime, groups[w.proc.group].min_vruntime - TIME_SLICE / 2.0);
+                w.proc.is_blocked = false;
+                enqueue(w.proc, vruntime);
+            }
+
+            // mover processos para a fila de execução
+            while (!arrival_queue.empty() && arrival_queue.front().creation_time <= cpu_time)
+            {
+                Process proc = arrival_queue.front();
+                arrival_queue.pop();
+                enqueue(proc, 0.0);
+            }
+
+            if (!any_ready())
+            {
+                cpu_time++;
+                continue;
+            }
+
+            double vruntime;
+            Process proc = pick_next(vruntime);
+            cpu_time += switch_costs.dispatch(proc.pid, cpu_time, verbose);
+
+            int slice = std::min(TIME_SLICE, proc.remaining_time);
+            int start = cpu_time;
+            int end = cpu_time + slice;
+
+            if (verbose)
+                std::cout << "Tempo[" << std::setw(3) << start << " -> " << std::setw(3) << end << "]: Processo "
+                          << proc.pid << " esta na CPU. (Restante: " << (proc.remaining_time - slice) << ")\n";
+
+            proc.mark_running(cpu_time);
+
+            cpu_time += slice;
+            proc.remaining_time -= slice;
+            switch_costs.ran(proc.pid, slice);
+
+            if (sink)
+                sink->on_slice(start, end, proc.pid, proc.remaining_time > 0 ? REASON_PREEMPT : (proc.has_io_next() ? REASON_BLOCK : REASON_FINISH));
+
+            // Calcula o novo vruntime baseado no tempo de execução do processo (slice).
+            // Fórmula: vruntime += (tempo_executado * MIN_WEIGHT) / peso_do_processo
+            // Quanto maior o peso (maior prioridade), mais lentamente o vruntime cresce,
+            // permitindo que o processo tenha mais tempo de CPU ao longo do tempo.
+            double new_vruntime = vruntime + (static_cast<double>(slice) * MIN_WEIGHT) / proc.weights;
+
+            if (proc.remaining_time > 0)
+            {
+                groups[proc.group].run_queue.insert({{new_vruntime, proc.pid}, proc});
+            }
+            else if (proc.has_io_next())
+            {
+                int wake_time = proc.start_io(cpu_time);
+                if (verbose)
+                    std::cout << ">>> Processo " << proc.pid << " bloqueado em E/S ate o tempo " << wake_time << " <<<\n";
+                sleeping.insert(wake_time, {new_vruntime, proc});
+            }
+            else
+            {
+                proc.end_time = cpu_time;
+                proc.is_finished = true;
+                statistics.append(proc);
+                if (verbose)
+                    std::cout << ">>> Processo " << proc.pid << " finalizado no tempo " << cpu_time << " <<<\n";
+                finished_processes.push_back(proc);
+            }
+            charge_groups(proc.group, slice);
+        }
+
+        if (verbose)
+            std::cout << "\n--- Simulacao finalizada no tempo " << cpu_time << " ---\n";
+    }
+
+    void print_statistics(bool per_process = true)
+    {
+        print_statistics_table(finished_processes, statistics, cpu_time, per_process, &switch_costs);
+        if (groups.size() > 1)
+        {
+            print_group_statistics();
+        }
+    }
+
+    // Parcela da CPU e latencia de cada grupo, somando os subgrupos.
+    // A parcela e medida so enquanto todos os irmaos do grupo estavam prontos (quando o peso
+    // decide a divisao) e comparada com a esperada pelo peso; "-" se isso nunca aconteceu.
+    void print_group_statistics()
+    {
+        std::vector<long long> contended_total(groups.size(), 0); // CPU dos filhos de cada grupo com todos prontos
+        std::vector<long long> sibling_weights(groups.size(), 0);
+        for (size_t g = 1; g < groups.size(); ++g)
+        {
+            contended_total[groups[g].parent] += groups[g].contended_cpu;
+            sibling_weights[groups[g].parent] += groups[g].weight;
+        }
+        std::vector<long long> members(groups.size(), 0);
+        std::vector<long long> total_waiting(groups.size(), 0);
+        std::vector<double> total_response(groups.size(), 0.0);
+        std::vector<int> max_waiting(groups.size(), 0);
+        for (const auto &proc : finished_processes)
+        {
+            int waiting_time = proc.end_time - proc.creation_time - proc.burst_time - proc.io_time;
+            for (int g = proc.group; g != -1; g = groups[g].parent)
+            {
+                members[g]++;
+                total_waiting[g] += waiting_time;
+                total_response[g] += proc.get_mean_response_time();
+                max_waiting[g] = std::max(max_waiting[g], waiting_time);
+            }
+        }
+
+        std::cout << "\n--- Estatisticas por Grupo ---\n";
+        std::cout << std::left << std::setw(15) << "Grupo" << std::setw(15) << "Pai" << std::setw(8) << "Peso"
+                  << std::setw(12) << "CPU" << std::setw(18) << "Parcela Disputa %" << std::setw(12) << "Esperada %" << std::setw(15) << "Pronto Medio"
+                  << std::setw(15) << "Pronto Max" << "Resposta Media" << std::endl;
+        std::cout << "----------------------------------------------------------------------------------------------------------------------------\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (size_t g = 1; g < groups.size(); ++g)
+        {
+            const Group &group = groups[g];
+            long long contended = contended_total[group.parent];
+            std::ostringstream share;
+            if (contended > 0)
+                share << std::fixed << std::setprecision(2) << 100.0 * group.contended_cpu / contended;
+            else
+                share << "-";
+            double expected = 100.0 * group.weight / sibling_weights[group.parent];
+            double divisor = members[g] > 0 ? static_cast<double>(members[g]) : 1.0;
+            std::cout << std::left << std::setw(15) << group.name << std::setw(15) << groups[group.parent].name
+                      << std::setw(8) << group.weight << std::setw(12) << group.cpu_time
+                      << std::setw(18) << share.str() << std::setw(12) << expected
+                      << std::setw(15) << total_waiting[g] / divisor << std::setw(15) << max_waiting[g]
+                      << total_response[g] / divisor << std::endl;
+        }
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+};
+
+// Escalonador por Alternancia Circular
+
+class RoundRobinScheduler
+{
+public:
+    RoundRobinScheduler();
+    void set_algorithm_name(const std::string &name);
+    void set_quantum(int q);
+    void set_event_sink(EventSink *s);
+    void set_verbose(bool v);
+    void set_switch_cost_model(const SwitchCostModel &model);
+    void add_process(const Process &process);
+    void run();
+    void print_statistics(bool per_process = true); // per_process = false imprime so os agregados
+
+private:
+    void update_ready_queue();
+    void wake_processes(); // processos cuja E/S terminou voltam para o fim da fila
+    std::vector<Process> all_processes;
+    StatisticsColumns statistics; // colunas dos processos finalizados
+    std::queue<Process *> ready_queue;
+    TimingWheel<Process *> sleeping;
+    std::string algorithm_name;
+    int quantum;
+    int current_time;
+    size_t finished_process_count;
+    EventSink *sink;
+    bool verbose;
+    SwitchCostTracker switch_costs;
+};
+
+RoundRobinScheduler::RoundRobinScheduler()
+{
+    quantum = 0;
+    current_time = 0;
+    finished_process_count = 0;
+    sink = nullptr;
+    verbose = true;
+}
+
+void RoundRobinScheduler::set_algorithm_name(const std::string &name) { algorithm_name = name; }
+void RoundRobinScheduler::set_quantum(int q) { quantum = q; }
+void RoundRobinScheduler::set_event_sink(EventSink *s) { sink = s; }
+void RoundRobinScheduler::set_verbose(bool v) { verbose = v; }
+void RoundRobinScheduler::set_switch_cost_model(const SwitchCostModel &model) { switch_costs.set_model(model); }
+void RoundRobinScheduler::add_process(const Process &process) { all_processes.push_back(process); }
+
+void RoundRobinScheduler::update_ready_queue()
+{
+    for (auto &process : all_processes)
+    {
+        if (!process.is_finished && process.creation_time <= current_time)
+        {
+            bool in_queue = false;
+
+            std::queue<Process *> temp_q = ready_queue;
+            while (!temp_q.empty())
+            {
+                if (temp_q.front()->get_pid() == process.get_pid())
+                {
+                    in_queue = true;
+                    break;
+                }
+                temp_q.pop();
+            }
+            if (process.start_time != -1)
+                in_queue = true;
+
+            if (!in_queue)
+            {
+                ready_queue.push(&process);
+            }
+        }
+    }
+}
+
+void RoundRobinScheduler::wake_processes()
+{
+    std::vector<Process *> woken;
+    sleeping.advance(current_time, woken);
+    for (auto &process : woken)
+    {
+        process->is_blocked = false;
+        ready_queue.push(process);
+    }
+}
+
+void RoundRobinScheduler::run()
+{
+    if (verbose)
+    {
+        std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
+        std::cout << "Algoritmo: " << algorithm_name << " | Fatia de CPU: " << quantum << std::endl
+                  << std::endl;
+    }
+
+    while (finished_process_count < all_processes.size())
+    {
+        if (sink && sink->should_stop())
+        {
+            break;
+        }
+        wake_processes();
+        update_ready_queue();
+
+        if (ready_queue.empty())
+        {
+            current_time++;
+            continue;
+        }
+
+        Process *current_proc = ready_queue.front();
+        ready_queue.pop();
+
+        current_time += switch_costs.dispatch(current_proc->get_pid(), current_time, verbose);
+        current_proc->mark_running(current_time);
+
+        int time_to_run = std::min(current_proc->remaining_time, quantum);
+
+        if (verbose)
+        {
+            std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + time_to_run << "]: "
+                      << "Processo " << current_proc->get_pid() << " esta na CPU. (Restante: "
+                      << current_proc->remaining_time - time_to_run << ")" << std::endl;
+        }
+
+        current_time += time_to_run;
+        current_proc->remaining_time -= time_to_run;
+        switch_costs.ran(current_proc->get_pid(), time_to_run);
+
+        if (sink)
+        {
+            int reason = (current_proc->remaining_time > 0) ? REASON_PREEMPT : (current_proc->has_io_next() ? REASON_BLOCK : REASON_FINISH);
+            sink->on_slice(current_time - time_to_run, current_time, current_proc->get_pid(), reason);
+        }
+
+        wake_processes();
+        update_ready_queue();
+
+        if (current_proc->remaining_time > 0)
+        {
+            ready_queue.push(current_proc);
+        }
+        else if (current_proc->has_io_next())
+        {
+            int wake_time = current_proc->start_io(current_time);
+            sleeping.insert(wake_time, current_proc);
+            if (verbose)
+                std::cout << ">>> Processo " << current_proc->get_pid() << " bloqueado em E/S ate o tempo " << wake_time << " <<<" << std::endl;
+        }
+        else
+        {
+            current_proc->end_time = current_time;
+            current_proc->is_finished = true;
+            statistics.append(*current_proc);
+            finished_process_count++;
+            if (verbose)
+                std::cout << ">>> Processo " << current_proc->get_pid() << " finalizado no tempo " << current_time << " <<<" << std::endl;
+        }
+    }
+
+    if (verbose)
+        std::cout << "\n--- Simulacao finalizada no tempo " << current_time << " ---\n";
+}
+
+void RoundRobinScheduler::print_statistics(bool per_process)
+{
+    print_statistics_table(all_processes, statistics, current_time, per_process, &switch_costs);
+}
+
+// Escalonador por prazo mais proximo (EDF)
+
+struct EDFEntry // entrada do heap de prontos do EDF
+{
+    long long deadline; // prazo usado na ordenacao (sem prazo ou nao admitido = infinito)
+    int creation_time;
+    int pid;
+    Process *process;
+
+    bool operator<(const EDFEntry &other) const // o priority_queue e um heap de maximo, entao a comparacao e invertida
+    {
+        if (deadline != other.deadline)
+            return deadline > other.deadline;
+        if (creation_time != other.creation_time)
+            return creation_time > other.creation_time; // mesmo prazo: quem chegou antes
+        return pid > other.pid;
+    }
+};
+
+// Sempre executa o processo pronto de prazo absoluto mais proximo. Uma chegada ou um retorno
+// de E/S com prazo menor preempta o processo atual na hora.
+// Na chegada, o teste de densidade (soma de CPU/prazo relativo dos processos admitidos ainda
+// no sistema <= 1) decide se o prazo e aceito. Quem nao passa continua executando, mas em
+// segundo plano, junto com os processos sem prazo, para nao comprometer os prazos aceitos.
+class EDFScheduler
+{
+public:
+    EDFScheduler();
+    void set_quantum(int q);
+    void set_event_sink(EventSink *s);
+    void set_verbose(bool v);
+    void set_switch_cost_model(const SwitchCostModel &model);
+    void add_process(const Process &process);
+    void run();
+    void print_statistics(bool per_process = true); // per_process = false imprime so os agregados
+
+private:
+    long long effective_deadline(const Process &process) const;
+    void admit(Process &process);   // teste de densidade na chegada
+    void release(Process &process); // devolve a densidade de um processo admitido que terminou
+    void push_ready(Process *process);
+    void collect_ready(); // chegadas e retornos de E/S ate o tempo atual vao para o heap
+    void end_slice(Process *process, int start, int reason); // log e trace da fatia que acabou de terminar
+    std::vector<Process> all_processes;
+    StatisticsColumns statistics;              // colunas dos processos finalizados
+    std::priority_queue<EDFEntry> ready_queue; // heap por prazo, O(log n) por operacao
+    TimingWheel<Process *> sleeping;
+    size_t next_arrival; // proximo processo (ordenado por criacao) que ainda nao chegou
+    double density;      // soma de CPU/prazo dos processos admitidos no sistema
+    int quantum;         // fatia maxima entre pontos de decisao (0 = sem limite)
+    int current_time;
+    size_t finished_process_count;
+    EventSink *sink;
+    bool verbose;
+    SwitchCostTracker switch_costs;
+};
+
+EDFScheduler::EDFScheduler()
+{
+    next_arrival = 0;
+    density = 0.0;
+    quantum = 0;
+    current_time = 0;
+    finished_process_count = 0;
+    sink = nullptr;
+    verbose = true;
+}
+
+void EDFScheduler::set_quantum(int q) { quantum = q; }
+void EDFScheduler::set_event_sink(EventSink *s) { sink = s; }
+void EDFScheduler::set_verbose(bool v) { verbose = v; }
+void EDFScheduler::set_switch_cost_model(const SwitchCostModel &model) { switch_costs.set_model(model); }
+void EDFScheduler::add_process(const Process &process) { all_processes.push_back(process); }
+
+long long EDFScheduler::effective_deadline(const Process &process) const
+{
+    if (process.deadline < 0 || !process.admitted)
+        return std::numeric_limits<long long>::max();
+    return process.deadline;
+}
+
+void EDFScheduler::admit(Process &process)
+{
+    if (process.deadline < 0)
+        return;
+
+    int relative_deadline = process.deadline - process.creation_time;
+    double process_density = (relative_deadline > 0) ? static_cast<double>(process.burst_time) / relative_deadline
+                                                     : std::numeric_limits<double>::infinity();
+    if (density + process_density <= 1.0 + 1e-9)
+    {
+        density += process_density;
+        return;
+    }
+
+    process.admitted = false;
+    if (verbose)
+    {
+        std::cout << ">>> Processo " << process.pid << " nao admitido (densidade " << std::fixed << std::setprecision(2)
+                  << density << " + " << process_density << " > 1) <<<" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+}
+
+void EDFScheduler::release(Process &process)
+{
+    if (process.deadline < 0 || !process.admitted)
+        return;
+    density -= static_cast<double>(process.burst_time) / (process.deadline - process.creation_time);
+    if (density < 1e-9)
+        density = 0.0; // evita residuo de arredondamento
+}
+
+void EDFScheduler::push_ready(Process *process)
+{
+    ready_queue.push({effective_deadline(*process), process->creation_time, process->pid, process});
+}
+
+void EDFScheduler::collect_ready()
+{
+    while (next_arrival < all_processes.size() && all_processes[next_arrival].creation_time <= current_time)
+    {
+        Process *process = &all_processes[next_arrival++];
+        admit(*process);
+        push_ready(process);
+    }
+
+    std::vector<Process *> woken;
+    sleeping.advance(current_time, woken);
+    for (auto &process : woken)
+    {
+        process->is_blocked = false;
+        push_ready(process);
+    }
+}
+
+void EDFScheduler::end_slice(Process *process, int start, int reason)
+{
+    if (verbose)
+    {
+        std::cout << "Tempo[" << std::setw(3) << start << " -> " << std::setw(3) << current_time << "]: "
+                  << "Processo " << process->get_pid() << " esta na CPU. (Restante: "
+                  << process->remaining_time << ")" << std::endl;
+    }
+    if (sink)
+        sink->on_slice(start, current_time, process->get_pid(), reason);
+}
+
+void EDFScheduler::run()
+{
+    if (verbose)
+    {
+        std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
+        std::cout << "Algoritmo: edf | Fatia de CPU: " << quantum << std::endl
+                  << std::endl;
+    }
+
+    // As chegadas sao consumidas em ordem de criacao; os ponteiros do heap so sao tomados depois da ordenacao
+    std::stable_sort(all_processes.begin(), all_processes.end(), [](const Process &a, const Process &b)
+                     { return a.creation_time < b.creation_time; });
+
+    Process *current = nullptr;
+    int slice_start = 0;
+
+    while (finished_process_count < all_processes.size())
+    {
+        if (sink && sink->should_stop())
+        {
+            break;
+        }
+
+        collect_ready();
+
+        // Preempcao: alguem pronto tem prazo menor que o do processo na CPU
+        if (current && !ready_queue.empty() && ready_queue.top().deadline < effective_deadline(*current))
+        {
+            end_slice(current, slice_start, REASON_PREEMPT);
+            if (verbose)
+                std::cout << ">>> Processo " << current->pid << " preemptado pelo processo " << ready_queue.top().pid
+                          << " (prazo " << ready_queue.top().deadline << ") <<<" << std::endl;
+            push_ready(current);
+            current = nullptr;
+        }
+
+        if (!current)
+        {
+            if (ready_queue.empty())
+            {
+                // CPU ociosa: pula direto para a proxima chegada ou o proximo retorno de E/S
+                int next_event = std::numeric_limits<int>::max();
+                if (next_arrival < all_processes.size())
+                    next_event = all_processes[next_arrival].creation_time;
+                next_event = std::min(next_event, sleeping.next_wake());
+                current_time = next_event;
+                continue;
+            }
+            current = ready_queue.top().process;
+            ready_queue.pop();
+            int cost = switch_costs.dispatch(current->pid, current_time, verbose);
+            if (cost > 0)
+            {
+                // A troca consome tempo: quem chegou ou acordou durante ela entra na disputa
+                // antes da fatia comecar, senao a fatia seria limitada por um evento ja passado
+                current_time += cost;
+                collect_ready();
+                if (!ready_queue.empty() && ready_queue.top().deadline < effective_deadline(*current))
+                {
+                    push_ready(current);
+                    current = nullptr;
+                    continue;
+                }
+            }
+            slice_start = current_time;
+            current->mark_running(current_time);
+        }
+
+        // Executa ate o proximo ponto de decisao: fim da rajada, proxima chegada, proximo retorno de E/S ou fim do quantum
+        int time_to_run = current->remaining_time;
+        if (next_arrival < all_processes.size())
+            time_to_run = std::min(time_to_run, all_processes[next_arrival].creation_time - current_time);
+        if (!sleeping.empty())
+            time_to_run = std::min(time_to_run, sleeping.next_wake() - current_time);
+        if (quantum > 0)
+            time_to_run = std::min(time_to_run, quantum);
+
+        current_time += time_to_run;
+        current->remaining_time -= time_to_run;
+        switch_costs.ran(current->pid, time_to_run);
+
+        if (current->remaining_time > 0)
+        {
+            continue;
+        }
+
+        if (current->has_io_next())
+        {
+            end_slice(current, slice_start, REASON_BLOCK);
+            int wake_time = current->start_io(current_time);
+            sleeping.insert(wake_time, current);
+            if (verbose)
+                std::cout << ">>> Processo " << current->get_pid() << " bloqueado em E/S ate o tempo " << wake_time << " <<<" << std::endl;
+        }
+        else
+        {
+            end_slice(current, slice_start, REASON_FINISH);
+            current->end_time = current_time;
+            current->is_finished = true;
+            statistics.append(*current);
+            finished_process_count++;
+            release(*current);
+            if (verbose)
+            {
+                std::cout << ">>> Processo " << current->get_pid() << " finalizado no tempo " << current_time;
+                if (current->deadline >= 0 && current_time > current->deadline)
+                    std::cout << " (prazo " << current->deadline << " perdido)";
+                std::cout << " <<<" << std::endl;
+            }
+        }
+        current = nullptr;
+    }
+
+    if (verbose)
+        std::cout << "\n--- Simulacao finalizada no tempo " << current_time << " ---\n";
+}
+
+void EDFScheduler::print_statistics(bool per_process)
+{
+    print_statistics_table(all_processes, statistics, current_time, per_process, &switch_costs);
+}
+
+// Parametros de uma simulacao offline
+struct SimulationConfig
+{
+    int quantum = 0;
+    bool has_seed = false;        // semente fixa para o sorteio da loteria
+    unsigned seed = 0;
+    EventSink *sink = nullptr;    // recebe as fatias (opcional)
+    bool verbose = true;          // log da simulacao
+    bool print_statistics = true; // tabela de estatisticas finais
+    bool per_process_statistics = true; // linhas por processo na tabela (false = so os agregados)
+    SwitchCostModel switch_costs;       // custo das trocas de contexto
+};
+
+bool is_supported_algorithm(const std::string &algorithm)
+{
+    return algorithm == "loteria" || algorithm == "prioridade" || algorithm == "cfs" || algorithm == "alternanciacircular" ||
+           algorithm == "edf";
+}
+
+// Monta o escalonador do algoritmo com os processos lidos e roda a simulacao.
+// Retorna false se o algoritmo nao for suportado.
+bool run_simulation(const FileReader &reader, const std::string &algorithm, const SimulationConfig &config)
+{
+    const std::vector<int> &pids = reader.get_pids();
+    const std::vector<int> &creation_times = reader.get_creation_times();
+    const std::vector<int> &burst_times = reader.get_burst_times();
+    const std::vector<int> &ticket_values = reader.get_ticket_values();
+    const std::vector<std::vector<int>> &io_bursts = reader.get_io_bursts();
+    const std::vector<int> &deadlines = reader.get_deadlines();
+
+    if (algorithm == "loteria")
+    {
+        LotteryScheduler scheduler;
+        scheduler.set_algorithm_name(reader.get_algorithm());
+        scheduler.set_quantum(config.quantum);
+        scheduler.set_event_sink(config.sink);
+        scheduler.set_verbose(config.verbose);
+        scheduler.set_switch_cost_model(config.switch_costs);
+        if (config.has_seed)
+        {
+            scheduler.set_seed(config.seed);
+        }
+
+        for (size_t i = 0; i < pids.size(); ++i)
+        {
+            Process process(pids[i], creation_times[i], burst_times[i], ticket_values[i]);
+            process.set_io_bursts(io_bursts[i]);
+            process.set_deadline(deadlines[i]);
+            scheduler.add_process(process);
+        }
+
+        scheduler.run();
+        if (config.print_statistics)
+            scheduler.print_statistics(config.per_process_statistics);
+    }
+    else if (algorithm == "prioridade")
+    {
+        PriorityScheduler scheduler(config.quantum);
+        scheduler.set_event_sink(config.sink);
+        scheduler.set_verbose(config.verbose);
+        scheduler.set_switch_cost_model(config.switch_costs);
+
+        for (size_t i = 0; i < pids.size(); ++i)
+        {
+            scheduler.addProcess(pids[i], creation_times[i], burst_times[i], ticket_values[i], io_bursts[i], deadlines[i]);
+        }
+        scheduler.run();
+        if (config.print_statistics)
+            scheduler.print_statistics(config.per_process_statistics);
+    }
+    else if (algorithm == "cfs")
+    {
+        CFSScheduler scheduler(config.quantum);
+        scheduler.set_event_sink(config.sink);
+        scheduler.set_verbose(config.verbose);
+        scheduler.set_switch_cost_model(config.switch_costs);
+        scheduler.load_processes(reader);
+        scheduler.run();
+        if (config.print_statistics)
+            scheduler.print_statistics(config.per_process_statistics);
+    }
+    else if (algorithm == "alternanciacircular")
+    {
+        RoundRobinScheduler scheduler;
+        scheduler.set_algorithm_name(reader.get_algorithm());
+        scheduler.set_quantum(config.quantum);
+        scheduler.set_event_sink(config.sink);
+        scheduler.set_verbose(config.verbose);
+        scheduler.set_switch_cost_model(config.switch_costs);
+
+        for (size_t i = 0; i < pids.size(); ++i)
+        {
+            Process process(pids[i], creation_times[i], burst_times[i], ticket_values[i]);
+            process.set_io_bursts(io_bursts[i]);
+            process.set_deadline(deadlines[i]);
+            scheduler.add_process(process);
+        }
+
+        scheduler.run();
+        if (config.print_statistics)
+            scheduler.print_statistics(config.per_process_statistics);
+    }
+    else if (algorithm == "edf")
+    {
+        EDFScheduler scheduler;
+        scheduler.set_quantum(config.quantum);
+        scheduler.set_event_sink(config.sink);
+        scheduler.set_verbose(config.verbose);
+        scheduler.set_switch_cost_model(config.switch_costs);
+
+        for (size_t i = 0; i < pids.size(); ++i)
+        {
+            Process process(pids[i], creation_times[i], burst_times[i], ticket_values[i]);
+            process.set_io_bursts(io_bursts[i]);
+            process.set_deadline(deadlines[i]);
+            scheduler.add_process(process);
+        }
+
+        scheduler.run();
+        if (config.print_statistics)
+            scheduler.print_statistics(config.per_process_statistics);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// Varredura de parametros: avalia combinacoes de quantum (e sementes da loteria) em paralelo
+
+enum SweepObjective
+{
+    OBJECTIVE_TURNAROUND = 0,  // tempo total medio
+    OBJECTIVE_P99_WAITING = 1, // percentil 99 do tempo pronto
+    OBJECTIVE_SWITCHES = 2,    // trocas de contexto
+    OBJECTIVE_MAKESPAN = 3     // tempo ate o ultimo processo terminar (menor = maior vazao)
+};
+
+struct SweepOptions
+{
+    int quantum_min = 1;
+    int quantum_max = 0; // 0 = so o quantum do arquivo
+    unsigned seed_min = 1;
+    unsigned seed_max = 1;
+    int objective = OBJECTIVE_TURNAROUND;
+    int threads = 0; // 0 = numero de nucleos
+    SwitchCostModel switch_costs; // custo das trocas aplicado a todas as simulacoes
+};
+
+struct SweepResult // uma combinacao de parametros avaliada
+{
+    int quantum;
+    unsigned seed;
+    bool completed; // false se a simulacao foi interrompida pela poda
+    double mean_turnaround;
+    double p99_waiting;
+    long long context_switches;
+    int makespan;
+
+    double value(int objective) const
+    {
+        if (objective == OBJECTIVE_MAKESPAN)
+            return makespan;
+        if (objective == OBJECTIVE_P99_WAITING)
+            return p99_waiting;
+        if (objective == OBJECTIVE_SWITCHES)
+            return static_cast<double>(context_switches);
+        return mean_turnaround;
+    }
+};
+
+// Dados da carga compartilhados (somente leitura) entre as threads da varredura
+struct SweepWorkload
+{
+    std::vector<int> creation_times;
+    std::vector<int> cpu_times;                // CPU total de cada processo
+    std::vector<int> io_times;                 // E/S total de cada processo
+    std::vector<std::vector<int>> io_bursts;   // E/S, CPU, E/S, CPU... depois da primeira rajada
+    std::vector<int> arrival_order;            // indices ordenados por tempo de criacao
+    std::unordered_map<int, int> index_of_pid;
+
+    explicit SweepWorkload(const FileReader &reader)
+        : creation_times(reader.get_creation_times()), cpu_times(reader.get_burst_times()),
+          io_times(cpu_times.size(), 0), io_bursts(reader.get_io_bursts())
+    {
+        const std::vector<int> &pids = reader.get_pids();
+        for (size_t i = 0; i < pids.size(); ++i)
+        {
+            index_of_pid[pids[i]] = static_cast<int>(i);
+            arrival_order.push_back(static_cast<int>(i));
+            for (size_t j = 0; j + 1 < io_bursts[i].size(); j += 2)
+            {
+                io_times[i] += io_bursts[i][j];
+                cpu_times[i] += io_bursts[i][j + 1];
+            }
+        }
+        std::stable_sort(arrival_order.begin(), arrival_order.end(), [this](int a, int b)
+                         { return creation_times[a] < creation_times[b]; });
+    }
+};
+
+// Criterios comparados entre os candidatos: os tres da fronteira de Pareto mais o tempo de conclusao
+const int SWEEP_CRITERIA = 4;
+
+// Candidatos completos ja avaliados, compartilhados entre as threads da varredura
+class SweepFront
+{
+public:
+    void add(const SweepResult &result);
+    bool dominates(const double bounds[SWEEP_CRITERIA]) const; // algum candidato e <= bounds em todos e < em algum
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::vector<double>> points;
+};
+
+void SweepFront::add(const SweepResult &result)
+{
+    std::vector<double> point = {result.mean_turnaround, result.p99_waiting, static_cast<double>(result.context_switches),
+                                 static_cast<double>(result.makespan)};
+    std::lock_guard<std::mutex> lock(mutex);
+    points.push_back(point);
+}
+
+bool SweepFront::dominates(const double bounds[SWEEP_CRITERIA]) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &point : points)
+    {
+        bool no_worse = true;
+        bool better = false;
+        for (int c = 0; c < SWEEP_CRITERIA && no_worse; ++c)
+        {
+            no_worse = point[c] <= bounds[c];
+            better = better || point[c] < bounds[c];
+        }
+        if (no_worse && better)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Acompanha as fatias de uma simulacao da varredura e interrompe a simulacao quando algum
+// candidato completo domina os limites inferiores dela (melhor ou igual em todos os criterios
+// e estritamente melhor em algum): ela nao pode mais vencer, nem empatar, em nenhum objetivo
+// nem entrar na fronteira de Pareto.
+// Os limites usam o fato de que o tempo pronto de um processo nunca diminui:
+//   tempo pronto final >= agora - criacao - E/S feita - executado (ou 0 se ainda nao chegou)
+// e fica congelado enquanto o processo esta bloqueado em E/S.
+class SweepEvaluator : public EventSink
+{
+public:
+    SweepEvaluator(const SweepWorkload &workload, const SweepFront &front);
+    void on_slice(int start, int end, int pid, int reason) override;
+    bool should_stop() const override { return stopped; }
+    SweepResult result(int quantum, unsigned seed) const;
+
+private:
+    void activate(int index);   // processo passa a acumular tempo pronto (chegou ou acordou)
+    void deactivate(int index); // processo deixa de acumular tempo pronto (bloqueou ou terminou)
+    void lower_bounds(double bounds[SWEEP_CRITERIA]) const;
+    double p99(std::vector<int> values) const;
+    std::vector<int> waiting_lower_bounds() const;
+
+    const SweepWorkload &workload;
+    const SweepFront &front;
+    std::vector<int> executed;      // tempo de CPU ja recebido por processo
+    std::vector<int> end_times;     // -1 enquanto nao termina
+    std::vector<int> ready_origin;  // criacao + E/S ja feita: tempo pronto = agora - ready_origin - executado
+    std::vector<int> frozen_waiting; // tempo pronto acumulado ate bloquear (-1 = nao esta bloqueado)
+    std::vector<size_t> next_io;    // proxima E/S em io_bursts
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> wakeups; // (acorda, indice)
+    size_t next_arrival;        // proximo processo em arrival_order que ainda nao chegou
+    long long active_count;     // processos que ja chegaram, nao estao bloqueados e nao terminaram
+    long long active_origin;    // soma de ready_origin desses processos
+    long long active_executed;  // soma do tempo executado desses processos
+    long long frozen_total;     // soma do tempo pronto congelado dos bloqueados
+    long long unfinished_work;  // soma de CPU + E/S dos processos nao terminados
+    long long remaining_cpu;    // CPU que ainda falta executar (de todos os processos)
+    int makespan;               // fim do ultimo processo terminado
+    long long finished_turnaround;
+    size_t finished_count;
+    long long context_switches;
+    int last_pid;
+    int now;
+    size_t slices;
+    bool stopped;
+};
+
+SweepEvaluator::SweepEvaluator(const SweepWorkload &workload, const SweepFront &front)
+    : workload(workload), front(front),
+      executed(workload.cpu_times.size(), 0), end_times(workload.cpu_times.size(), -1),
+      ready_origin(workload.creation_times), frozen_waiting(workload.cpu_times.size(), -1), next_io(workload.cpu_times.size(), 0)
+{
+    next_arrival = 0;
+    active_count = 0;
+    active_origin = 0;
+    active_executed = 0;
+    frozen_total = 0;
+    unfinished_work = 0;
+    remaining_cpu = 0;
+    makespan = 0;
+    for (size_t i = 0; i < workload.cpu_times.size(); ++i)
+    {
+        unfinished_work += workload.cpu_times[i] + workload.io_times[i];
+        remaining_cpu += workload.cpu_times[i];
+    }
+    finished_turnaround = 0;
+    finished_count = 0;
+    context_switches = 0;
+    last_pid = -1;
+    now = 0;
+    slices = 0;
+    stopped = false;
+}
+
+void SweepEvaluator::activate(int index)
+{
+    active_count++;
+    active_origin += ready_origin[index];
+    active_executed += executed[index];
+}
+
+void SweepEvaluator::deactivate(int index)
+{
+    active_count--;
+    active_origin -= ready_origin[index];
+    active_executed -= executed[index];
+}
+
+void SweepEvaluator::on_slice(int start, int end, int pid, int reason)
+{
+    now = end;
+    while (next_arrival < workload.arrival_order.size() && workload.creation_times[workload.arrival_order[next_arrival]] <= now)
+    {
+        activate(workload.arrival_order[next_arrival]);
+        next_arrival++;
+    }
+    while (!wakeups.empty() && wakeups.top().first <= now)
+    {
+        int index = wakeups.top().second;
+        wakeups.pop();
+        frozen_total -= frozen_waiting[index];
+        frozen_waiting[index] = -1;
+        activate(index);
+    }
+
+    if (last_pid != -1 && pid != last_pid)
+    {
+        context_switches++;
+    }
+    last_pid = pid;
+
+    int index = workload.index_of_pid.at(pid);
+    executed[index] += end - start;
+    active_executed += end - start;
+    remaining_cpu -= end - start;
+
+    if (reason == REASON_BLOCK)
+    {
+        deactivate(index);
+        frozen_waiting[index] = end - ready_origin[index] - executed[index];
+        frozen_total += frozen_waiting[index];
+        int io = workload.io_bursts[index][next_io[index]];
+        next_io[index] += 2;
+        ready_origin[index] += io;
+        wakeups.push(std::make_pair(end + io, index));
+    }
+    else if (reason == REASON_FINISH)
+    {
+        deactivate(index);
+        end_times[index] = end;
+        unfinished_work -= workload.cpu_times[index] + workload.io_times[index];
+        finished_turnaround += end - workload.creation_times[index];
+        finished_count++;
+        makespan = end;
+    }
+
+    // O limite do p99 custa O(n), entao a poda so e verificada a cada n fatias
+    slices++;
+    if (slices % std::max<size_t>(64, executed.size()) != 0)
+    {
+        return;
+    }
+    double bounds[SWEEP_CRITERIA];
+    lower_bounds(bounds);
+    if (front.dominates(bounds))
+    {
+        stopped = true;
+    }
+}
+
+std::vector<int> SweepEvaluator::waiting_lower_bounds() const
+{
+    std::vector<int> waiting(executed.size(), 0);
+    for (size_t i = 0; i < executed.size(); ++i)
+    {
+        if (end_times[i] != -1)
+            waiting[i] = end_times[i] - workload.creation_times[i] - workload.cpu_times[i] - workload.io_times[i];
+        else if (frozen_waiting[i] != -1)
+            waiting[i] = frozen_waiting[i];
+        else if (workload.creation_times[i] <= now)
+            waiting[i] = now - ready_origin[i] - executed[i];
+    }
+    return waiting;
+}
+
+double SweepEvaluator::p99(std::vector<int> values) const
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    size_t k = (values.size() * 99 + 99) / 100 - 1; // posicao ceil(0.99 n) na ordem crescente
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+// Na mesma ordem de SweepFront: tempo total medio, p99 do tempo pronto, trocas e tempo de conclusao
+void SweepEvaluator::lower_bounds(double bounds[SWEEP_CRITERIA]) const
+{
+    // tempo total = CPU + E/S + tempo pronto, e o tempo pronto acumulado ate agora ja e um limite inferior
+    long long total = finished_turnaround + unfinished_work + active_count * now - active_origin - active_executed + frozen_total;
+    bounds[0] = static_cast<double>(total) / std::max<size_t>(1, executed.size());
+    bounds[1] = p99(waiting_lower_bounds());
+    bounds[2] = static_cast<double>(context_switches);
+    bounds[3] = static_cast<double>(now + remaining_cpu); // a CPU que falta ainda precisa ser executada, uma fatia por vez
+}
+
+SweepResult SweepEvaluator::result(int quantum, unsigned seed) const
+{
+    SweepResult r;
+    r.quantum = quantum;
+    r.seed = seed;
+    r.completed = !stopped && finished_count == executed.size();
+    r.mean_turnaround = static_cast<double>(finished_turnaround) / std::max<size_t>(1, executed.size());
+    r.p99_waiting = p99(waiting_lower_bounds());
+    r.context_switches = context_switches;
+    r.makespan = makespan;
+    return r;
+}
+
+// Roda as combinacoes em paralelo; cada thread pega a proxima combinacao livre
+void evaluate_sweep_batch(const FileReader &reader, const std::string &algorithm, const SweepWorkload &workload,
+                          const SweepOptions &options, SweepFront &front, std::vector<SweepResult> &batch)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        size_t i;
+        while ((i = next.fetch_add(1)) < batch.size())
+        {
+            SweepEvaluator evaluator(workload, front);
+            SimulationConfig config;
+            config.quantum = batch[i].quantum;
+            config.has_seed = true;
+            config.seed = batch[i].seed;
+            config.sink = &evaluator;
+            config.verbose = false;
+            config.print_statistics = false;
+            config.switch_costs = options.switch_costs;
+            run_simulation(reader, algorithm, config);
+
+            batch[i] = evaluator.result(batch[i].quantum, batch[i].seed);
+            if (batch[i].completed)
+            {
+                front.add(batch[i]);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.threads; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// Busca do grosso para o fino: avalia uma grade de quanta, centraliza a proxima grade
+// (mais estreita) no melhor quantum e repete ate o passo chegar a 1.
+void run_sweep(const FileReader &reader, const std::string &algorithm, SweepOptions options)
+{
+    static const char *objective_names[] = {"tempo total medio", "p99 do tempo pronto", "trocas de contexto", "tempo de conclusao"};
+    const int GRID_POINTS = 9;
+
+    if (options.quantum_max == 0)
+    {
+        options.quantum_min = options.quantum_max = reader.get_quantum();
+    }
+    if (options.threads <= 0)
+    {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (algorithm != "loteria") // a semente so muda o resultado da loteria
+    {
+        options.seed_max = options.seed_min;
+    }
+
+    std::cout << "--- Varredura de Parametros ---\n";
+    std::cout << "Algoritmo: " << algorithm << " | Objetivo: " << objective_names[options.objective]
+              << " | Quantum: " << options.quantum_min << ".." << options.quantum_max;
+    if (algorithm == "loteria")
+        std::cout << " | Sementes: " << options.seed_min << ".." << options.seed_max;
+    std::cout << " | Threads: " << options.threads;
+    if (options.switch_costs.enabled())
+        std::cout << " | Troca: " << options.switch_costs.switch_cost << " | Cache: " << options.switch_costs.cache_penalty
+                  << " (tau " << options.switch_costs.cache_decay << ")";
+    std::cout << "\n\n";
+
+    SweepWorkload workload(reader);
+    SweepFront front;
+    std::vector<SweepResult> results;
+    std::set<int> evaluated;
+
+    int low = options.quantum_min;
+    int high = options.quantum_max;
+    while (true)
+    {
+        int step = std::max(1, (high - low) / (GRID_POINTS - 1));
+        std::vector<int> grid;
+        for (int q = low; q < high; q += step)
+        {
+            grid.push_back(q);
+        }
+        grid.push_back(high);
+
+        std::vector<SweepResult> batch;
+        for (int q : grid)
+        {
+            if (!evaluated.insert(q).second)
+                continue;
+            for (unsigned seed = options.seed_min; seed <= options.seed_max; ++seed)
+            {
+                SweepResult candidate = {q, seed, false, 0.0, 0.0, 0, 0};
+                batch.push_back(candidate);
+            }
+        }
+        evaluate_sweep_batch(reader, algorithm, workload, options, front, batch);
+        results.insert(results.end(), batch.begin(), batch.end());
+
+        const SweepResult *best_result = nullptr;
+        for (const auto &r : results)
+        {
+            if (r.completed && (best_result == nullptr || r.value(options.objective) < best_result->value(options.objective)))
+                best_result = &r;
+        }
+        if (step == 1 || best_result == nullptr)
+        {
+            break;
+        }
+        low = std::max(options.quantum_min, best_result->quantum - step);
+        high = std::min(options.quantum_max, best_result->quantum + step);
+    }
+
+    std::sort(results.begin(), results.end(), [](const SweepResult &a, const SweepResult &b)
+              { return a.quantum != b.quantum ? a.quantum < b.quantum : a.seed < b.seed; });
+
+    std::cout << std::left << std::setw(10) << "Quantum" << std::setw(10) << "Semente"
+              << std::setw(20) << "Tempo Total Medio" << std::setw(20) << "P99 Tempo Pronto"
+              << std::setw(10) << "Trocas" << std::setw(10) << "Fim" << "Situacao" << std::endl;
+    std::cout << "------------------------------------------------------------------------------------------\n";
+    size_t pruned = 0;
+    const SweepResult *best_result = nullptr;
+    for (const auto &r : results)
+    {
+        std::cout << std::left << std::setw(10) << r.quantum << std::setw(10) << r.seed;
+        if (!r.completed)
+        {
+            pruned++;
+            std::cout << std::setw(60) << "-" << "interrompida (dominada por outra)" << std::endl;
+            continue;
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::setw(20) << r.mean_turnaround << std::setw(20) << r.p99_waiting
+                  << std::setw(10) << r.context_switches << std::setw(10) << r.makespan << "completa" << std::endl;
+        if (best_result == nullptr || r.value(options.objective) < best_result->value(options.objective))
+            best_result = &r;
+    }
+
+    std::cout << "\nAvaliadas: " << results.size() << " | Interrompidas pela poda: " << pruned << "\n";
+    if (best_result != nullptr)
+    {
+        std::cout << "Melhor: quantum " << best_result->quantum;
+        if (algorithm == "loteria")
+            std::cout << " (semente " << best_result->seed << ")";
+        std::cout << " -> " << objective_names[options.objective] << " = " << best_result->value(options.objective) << "\n";
+    }
+
+    // Fronteira de Pareto entre as combinacoes completas: nenhuma outra e melhor ou igual nos quatro criterios.
+    // A poda so interrompe candidatos dominados, entao a fronteira e exata.
+    std::cout << "\n--- Fronteira de Pareto (tempo total medio, p99 do tempo pronto, trocas, tempo de conclusao) ---\n";
+    for (const auto &r : results)
+    {
+        if (!r.completed)
+            continue;
+        bool dominated = false;
+        for (const auto &other : results)
+        {
+            if (!other.completed || &other == &r)
+                continue;
+            bool no_worse = other.mean_turnaround <= r.mean_turnaround && other.p99_waiting <= r.p99_waiting &&
+                            other.context_switches <= r.context_switches && other.makespan <= r.makespan;
+            bool better = other.mean_turnaround < r.mean_turnaround || other.p99_waiting < r.p99_waiting ||
+                          other.context_switches < r.context_switches || other.makespan < r.makespan;
+            if (no_worse && better)
+            {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated)
+        {
+            std::cout << "quantum " << r.quantum;
+            if (algorithm == "loteria")
+                std::cout << " semente " << r.seed;
+            std::cout << ": " << r.mean_turnaround << " | " << r.p99_waiting << " | " << r.context_switches << " | " << r.makespan << "\n";
+        }
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Modo online: chegadas publicadas por threads produtoras enquanto o escalonador roda
+
+struct Arrival // chegada publicada por um produtor
+{
+    int pid;
+    int creation_time; // negativo = chegou "agora" (carimbado pelo escalonador)
+    int burst_time;
+    int row;           // linha do arquivo: tickets, rajadas de E/S e prazo sao lidos dela na entrada
+};
+
+// Ordem de entrada das chegadas drenadas: por criacao e depois por pid, e nao pela ordem em que
+// os produtores conseguiram publicar, para que a simulacao nao dependa do entrelacamento das threads
+struct LaterArrival
+{
+    bool operator()(const Arrival &a, const Arrival &b) const
+    {
+        if (a.creation_time != b.creation_time)
+            return a.creation_time > b.creation_time;
+        return a.pid > b.pid;
+    }
+};
+
+struct Completion // conclusao devolvida pelo escalonador
+{
+    int pid;
+    int creation_time;
+    int burst_time;
+    int end_time;
+};
+
+// Espera de quem depende de outra thread (anel cheio ou vazio, produtor atrasado): algumas
+// cedencias e depois sonecas que dobram ate 1 ms, para nao manter um nucleo girando a toa
+class Backoff
+{
+public:
+    void wait();
+    void reset() { rounds = 0; } // chamar quando houve progresso
+
+private:
+    static const int YIELDS = 16;
+    static const int MAX_SLEEP_US = 1000;
+    int rounds = 0;
+};
+
+const int Backoff::YIELDS;
+const int Backoff::MAX_SLEEP_US;
+
+void Backoff::wait()
+{
+    if (rounds < YIELDS)
+    {
+        std::this_thread::yield();
+        rounds++;
+        return;
+    }
+    int sleep_us = 1 << std::min(rounds - YIELDS, 10);
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min(sleep_us, MAX_SLEEP_US)));
+    if (sleep_us < MAX_SLEEP_US)
+        rounds++;
+}
+
+// Anel limitado multi-produtor / consumidor unico (esquema de Vyukov).
+// Cada celula guarda um numero de sequencia que indica se ela esta livre para o
+// proximo produtor ou pronta para o consumidor, entao nenhum lado usa trava.
+template <typename T>
+class MpscRing
+{
+public:
+    explicit MpscRing(size_t capacity); // capacidade precisa ser potencia de 2
+    bool try_push(const T &value);      // chamado por qualquer produtor; false se cheio
+    bool try_pop(T &value);             // chamado apenas pelo consumidor; false se vazio
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    std::vector<Cell> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail; // disputado pelos produtores
+    alignas(64) size_t head;              // so o consumidor mexe
+};
+
+template <typename T>
+MpscRing<T>::MpscRing(size_t capacity) : cells(capacity), mask(capacity - 1), tail(0), head(0)
+{
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool MpscRing<T>::try_push(const T &value)
+{
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell &cell = cells[pos & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        long diff = static_cast<long>(sequence) - static_cast<long>(pos);
+        if (diff == 0) // celula livre: tenta reservar a posicao
+        {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
             {
-                processes[k++] = R[j++];
+                cell.value = value;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
             }
         }
-        while (i < n1)
-            processes[k++] = L[i++];
-        while (j < n2)
-            processes[k++] = R[j++];
+        else if (diff < 0) // o consumidor ainda nao liberou a celula -> anel cheio
+        {
+            return false;
+        }
+        else // outro produtor pegou a posicao antes
+        {
+            pos = tail.load(std::memory_order_relaxed);
+        }
     }
+}
 
-    void merge_sort(std::vector<Process> &processes, int left, int right) // Função para ordenar os processos com merge sort
+template <typename T>
+bool MpscRing<T>::try_pop(T &value)
+{
+    Cell &cell = cells[head & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != head + 1)
     {
-        if (left >= right)
-        {
-            return;
-        }
+        return false;
+    }
+    value = cell.value;
+    cell.sequence.store(head + mask + 1, std::memory_order_release); // devolve a celula para a proxima volta
+    head++;
+    return true;
+}
 
-        int mid = left + (right - left) / 2;
+// Anel limitado produtor unico / consumidor unico, usado para devolver as conclusoes
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity); // capacidade precisa ser potencia de 2
+    bool try_push(const T &value);
+    bool try_pop(T &value);
 
-        merge_sort(processes, left, mid);
-        merge_sort(processes, mid + 1, right);
+private:
+    std::vector<T> buffer;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head;
+    alignas(64) std::atomic<size_t> tail;
+};
 
-        merge(processes, left, mid, right);
+template <typename T>
+SpscRing<T>::SpscRing(size_t capacity) : buffer(capacity), mask(capacity - 1), head(0), tail(0) {}
+
+template <typename T>
+bool SpscRing<T>::try_push(const T &value)
+{
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) > mask)
+    {
+        return false;
     }
+    buffer[t & mask] = value;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
 
-    void heapify_up(int index) // Função para manter a propriedade do heap ao inserir um novo processo
+template <typename T>
+bool SpscRing<T>::try_pop(T &value)
+{
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
     {
-        if (index == 0)
-            return;
-        int parent_index = (index - 1) / 2;
+        return false;
+    }
+    value = buffer[h & mask];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
 
-        if (comparator(ready_queue[parent_index], ready_queue[index]))
-        {
-            manual_swap(ready_queue[parent_index], ready_queue[index]);
-            heapify_up(parent_index);
-        }
+// Escalonador online: drena o anel de chegadas a cada ponto de decisao.
+// Suporta as politicas de alternancia circular e CFS.
+// Cada produtor publica uma marca d'agua (nenhuma chegada futura dele tem criacao menor que ela)
+// e quantas chegadas ja publicou. O escalonador so decide no tempo t quando todas as marcas
+// passaram de t e ja drenou tudo o que foi contado, entao nenhuma chegada anterior a t ainda
+// pode estar no anel (nem atras da celula de outro produtor que ainda esta escrevendo).
+class OnlineScheduler
+{
+public:
+    OnlineScheduler(const std::string &algorithm, const FileReader &reader, int producer_count, MpscRing<Arrival> &arrivals, SpscRing<Completion> &completions);
+    void set_tick_us(int us);   // microssegundos reais por unidade de tempo simulado (0 = o mais rapido possivel)
+    void set_verbose(bool v);   // imprime ou nao cada fatia de CPU
+    void set_event_sink(EventSink *s);
+    void set_switch_cost_model(const SwitchCostModel &model);
+    void publish_progress(int producer, long long published, int watermark); // chamado pelo produtor depois de cada chegada
+    void close_arrivals();      // avisa que nenhum produtor vai publicar mais nada
+    bool is_finished() const;   // true depois que a ultima conclusao foi publicada
+    void run();
+    void print_statistics(bool per_process = true);
+    long long get_arrival_count() const;
+
+private:
+    struct ProducerProgress // uma linha de cache por produtor
+    {
+        std::atomic<int> watermark;
+        std::atomic<long long> published;
+        char padding[64 - sizeof(std::atomic<int>) - sizeof(std::atomic<long long>)];
+    };
+    int min_watermark(long long &published) const; // menor marca e total publicado (lido depois das marcas)
+    void drain_arrivals();                  // move o que estiver no anel para a fila de pendentes
+    int drain_to_watermark();               // drena ate as marcas dos produtores passarem do tempo atual
+    void admit_pending();                   // pendentes com tempo de criacao <= atual entram na fila de prontos
+    void enqueue_ready(int slot, double vruntime);
+    void wake_sleepers();                   // quem terminou a E/S ate o tempo atual volta para a fila de prontos
+    int next_slot();                        // retira o proximo processo da fila de prontos
+    void sync_to_wall_clock(int sim_time);  // espera o relogio real alcancar o tempo simulado
+    int elapsed_ticks() const;
+
+    std::string algorithm;
+    int quantum;
+    int current_time;
+    int tick_us;
+    bool verbose;
+    EventSink *sink;
+    const FileReader &reader; // atributos de cada linha publicada (tickets, rajadas de E/S, prazo)
+    long long arrival_count;
+    MpscRing<Arrival> &arrivals;
+    SpscRing<Completion> &completions;
+    std::atomic<bool> producers_done;
+    std::atomic<bool> finished;
+    std::vector<ProducerProgress> progress;
+    std::chrono::steady_clock::time_point start_wall;
+    std::vector<Process> finished_processes; // com o log ligado todos (tabela por processo); sem ele so os com prazo
+    StatisticsColumns statistics;
+    SwitchCostTracker switch_costs;
+
+    std::vector<Process> slots;     // processos vivos; os slots de processos finalizados sao reaproveitados
+    std::vector<double> vruntimes;  // vruntime de cada slot (CFS)
+    std::vector<int> free_slots;
+    std::priority_queue<Arrival, std::vector<Arrival>, LaterArrival> pending; // drenadas que ainda nao chegaram (criacao ja carimbada)
+    std::deque<int> rr_queue;       // fila circular (alternancia circular)
+    std::map<CFSKey, int> cfs_tree; // arvore por vruntime (CFS); o desempate usa o slot
+    TimingWheel<int> sleeping;      // slots bloqueados em E/S
+    std::vector<int> woken;
+    double min_vruntime;
+};
+
+OnlineScheduler::OnlineScheduler(const std::string &algorithm, const FileReader &reader, int producer_count, MpscRing<Arrival> &arrivals, SpscRing<Completion> &completions)
+    : reader(reader), arrivals(arrivals), completions(completions), producers_done(false), finished(false), progress(producer_count)
+{
+    for (auto &p : progress)
+    {
+        p.watermark.store(std::numeric_limits<int>::min(), std::memory_order_relaxed); // nada publicado ainda
+        p.published.store(0, std::memory_order_relaxed);
     }
-    void heapify_down(int index) // Função para manter a propriedade do heap ao remover o processo de maior prioridade
+    this->algorithm = algorithm;
+    this->quantum = reader.get_quantum();
+    this->current_time = 0;
+    this->tick_us = 0;
+    this->verbose = true;
+    this->sink = nullptr;
+    this->arrival_count = 0;
+    this->min_vruntime = 0.0;
+}
+
+void OnlineScheduler::set_tick_us(int us) { tick_us = us; }
+void OnlineScheduler::set_verbose(bool v) { verbose = v; }
+void OnlineScheduler::set_event_sink(EventSink *s) { sink = s; }
+void OnlineScheduler::set_switch_cost_model(const SwitchCostModel &model) { switch_costs.set_model(model); }
+void OnlineScheduler::publish_progress(int producer, long long published, int watermark)
+{
+    progress[producer].published.store(published, std::memory_order_release);
+    if (progress[producer].watermark.load(std::memory_order_relaxed) != watermark)
     {
-        int left_child_index = 2 * index + 1;
-        int right_child_index = 2 * index + 2;
-        int largest = index;
+        progress[producer].watermark.store(watermark, std::memory_order_release);
+    }
+}
+void OnlineScheduler::close_arrivals() { producers_done.store(true, std::memory_order_release); }
+bool OnlineScheduler::is_finished() const { return finished.load(std::memory_order_acquire); }
+long long OnlineScheduler::get_arrival_count() const { return arrival_count; }
 
-        if (left_child_index < ready_queue.size() && comparator(ready_queue[largest], ready_queue[left_child_index]))
+int OnlineScheduler::min_watermark(long long &published) const
+{
+    int watermark = std::numeric_limits<int>::max();
+    for (const auto &p : progress)
+    {
+        watermark = std::min(watermark, p.watermark.load(std::memory_order_acquire));
+    }
+    published = 0;
+    for (const auto &p : progress)
+    {
+        published += p.published.load(std::memory_order_acquire);
+    }
+    return watermark;
+}
+
+int OnlineScheduler::elapsed_ticks() const
+{
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_wall).count();
+    return static_cast<int>(us / tick_us);
+}
+
+void OnlineScheduler::sync_to_wall_clock(int sim_time)
+{
+    if (tick_us > 0)
+    {
+        std::this_thread::sleep_until(start_wall + std::chrono::microseconds(static_cast<long long>(sim_time) * tick_us));
+    }
+}
+
+void OnlineScheduler::drain_arrivals()
+{
+    Arrival arrival;
+    while (arrivals.try_pop(arrival))
+    {
+        if (arrival.creation_time < 0)
         {
-            largest = left_child_index;
+            arrival.creation_time = current_time;
         }
-        if (right_child_index < ready_queue.size() && comparator(ready_queue[largest], ready_queue[right_child_index]))
+        pending.push(arrival);
+        arrival_count++;
+    }
+}
+
+int OnlineScheduler::drain_to_watermark()
+{
+    Backoff backoff;
+    while (true)
+    {
+        long long published;
+        int watermark = min_watermark(published); // lida antes de drenar: o que veio antes dela ja esta no anel
+        drain_arrivals();
+        if (watermark > current_time && arrival_count >= published)
         {
-            largest = right_child_index;
+            return watermark;
         }
+        backoff.wait(); // um produtor atrasado ainda pode publicar uma chegada ate o tempo atual
+    }
+}
 
-        if (largest != index)
+void OnlineScheduler::admit_pending()
+{
+    while (!pending.empty() && pending.top().creation_time <= current_time)
+    {
+        const Arrival &arrival = pending.top();
+        Process process(arrival.pid, arrival.creation_time, arrival.burst_time, reader.get_ticket_values()[arrival.row]);
+        process.set_io_bursts(reader.get_io_bursts()[arrival.row]);
+        process.set_deadline(reader.get_deadlines()[arrival.row]);
+        pending.pop();
+
+        // O slot so e escolhido na entrada, em ordem deterministica, porque desempata o CFS
+        int slot;
+        if (!free_slots.empty())
         {
-            manual_swap(ready_queue[index], ready_queue[largest]);
-            heapify_down(largest);
+            slot = free_slots.back();
+            free_slots.pop_back();
+            slots[slot] = process;
+        }
+        else
+        {
+            slot = static_cast<int>(slots.size());
+            slots.push_back(process);
+            vruntimes.push_back(0.0);
         }
+        // Um processo novo entra com o menor vruntime da arvore para nao monopolizar a CPU
+        enqueue_ready(slot, min_vruntime);
     }
+}
 
-public:
-    PriorityScheduler(int q) : quantum(q) {} // Construtor que recebe a fatia de CPU
+void OnlineScheduler::enqueue_ready(int slot, double vruntime)
+{
+    if (algorithm == "cfs")
+    {
+        vruntimes[slot] = vruntime;
+        cfs_tree.insert({{vruntime, slot}, slot});
+    }
+    else
+    {
+        rr_queue.push_back(slot);
+    }
+}
 
-    void addProcess(int pid, int creation_time, int burst_time, int priority) // Adiciona um processo à fila de pendentes
+void OnlineScheduler::wake_sleepers()
+{
+    woken.clear();
+    sleeping.advance(current_time, woken);
+    for (int slot : woken)
     {
-        pending_processes.emplace_back(pid, creation_time, burst_time, priority);
+        slots[slot].is_blocked = false;
+        // Como no CFS offline: quem dormiu volta perto do menor vruntime, sem acumular credito
+        enqueue_ready(slot, std::max(vruntimes[slot], min_vruntime - quantum / 2.0));
     }
+}
 
-    void run()
+int OnlineScheduler::next_slot()
+{
+    if (algorithm == "cfs")
     {
-        std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
-        std::cout << "Algoritmo: prioridade | Fatia de CPU: " << quantum << std::endl
+        auto it = cfs_tree.begin();
+        int slot = it->second;
+        min_vruntime = std::max(min_vruntime, it->first.vruntime);
+        cfs_tree.erase(it);
+        return slot;
+    }
+    int slot = rr_queue.front();
+    rr_queue.pop_front();
+    return slot;
+}
+
+void OnlineScheduler::run()
+{
+    start_wall = std::chrono::steady_clock::now();
+
+    if (verbose)
+    {
+        std::cout << "--- Iniciando Simulacao do Escalonador (online) ---\n";
+        std::cout << "Algoritmo: " << algorithm << " | Fatia de CPU: " << quantum << std::endl
                   << std::endl;
+    }
 
-        if (!pending_processes.empty())
+    Backoff backoff;
+    while (true)
+    {
+        if (sink && sink->should_stop())
         {
-            merge_sort(pending_processes, 0, pending_processes.size() - 1);
+            break;
         }
-        while (!ready_queue.empty() || !pending_processes.empty())
+        bool done = producers_done.load(std::memory_order_acquire); // lido antes de drenar para nao perder a ultima chegada
+        int watermark = drain_to_watermark();
+        wake_sleepers();
+        admit_pending();
+
+        if (rr_queue.empty() && cfs_tree.empty())
         {
-            auto it = pending_processes.begin();
-            while (it != pending_processes.end())
+            if (pending.empty() && sleeping.empty())
             {
-                if (it->creation_time <= current_time)
-                {
-                    ready_queue.push_back(*it);
-                    heapify_up(ready_queue.size() - 1);
-
-                    it = pending_processes.erase(it);
-                }
-                else
+                if (done)
                 {
                     break;
                 }
-            }
-
-            if (!ready_queue.empty())
-            {
-                Process p = ready_queue.front();
-                manual_swap(ready_queue.front(), ready_queue.back());
-                ready_queue.pop_back();
-                if (!ready_queue.empty())
-                {
-                    heapify_down(0);
-                }
-                if (p.start_time == -1)
-                {
-                    p.start_time = current_time;
-                }
-                int execution_time = (quantum < p.remaining_time) ? quantum : p.remaining_time;
-
-                std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + execution_time << "]: "
-                          << "Processo " << p.pid << " esta na CPU. (Restante: "
-                          << p.remaining_time - execution_time << ")" << std::endl;
-
-                current_time += execution_time;
-                p.remaining_time -= execution_time;
-
-                if (p.remaining_time > 0)
+                if (tick_us > 0)
                 {
-                    ready_queue.push_back(p);
-                    heapify_up(ready_queue.size() - 1);
+                    // CPU ociosa: o tempo simulado acompanha o relogio e a thread dorme ate o proximo tick
+                    current_time = std::max(current_time, elapsed_ticks());
+                    sync_to_wall_clock(current_time + 1);
                 }
                 else
                 {
-                    p.end_time = current_time;
-                    std::cout << ">>> Processo " << p.pid << " finalizado no tempo " << current_time << " <<<" << std::endl;
-                    finalizados.push_back(p);
+                    backoff.wait();
                 }
+                continue;
+            }
+            backoff.reset();
+            // Proximo evento conhecido: uma chegada pendente ou o fim de uma E/S
+            int next_event = sleeping.next_wake();
+            if (!pending.empty())
+            {
+                next_event = std::min(next_event, pending.top().creation_time);
+            }
+            if (tick_us == 0)
+            {
+                // Pula para o proximo evento, mas nao alem das marcas dos produtores
+                current_time = std::min(next_event, watermark);
             }
             else
             {
-                current_time++;
+                current_time = std::max(current_time, std::min(next_event, elapsed_ticks()));
+                if (current_time < next_event)
+                {
+                    sync_to_wall_clock(current_time + 1); // dorme ate o proximo tick
+                }
             }
+            continue;
         }
-        std::cout << "\n--- Estatisticas Finais ---\n";
-        std::cout << std::left << std::setw(10) << "PID"
-                  << std::setw(25) << "Tempo Total"
-                  << std::setw(25) << "Tempo Pronto" << std::endl;
-        std::cout << "------------------------------------------------------------\n";
-        for (const auto &p : finalizados)
-        {
-            int turnaround_time = (p.end_time - p.creation_time);
-            int waiting_time = turnaround_time - p.burst_time;
-            std::cout << std::left << std::setw(10) << p.pid
-                      << std::setw(25) << turnaround_time
-                      << std::setw(25) << waiting_time << std::endl;
-        }
-    }
-};
-
-// Escalonador CFS
+        backoff.reset();
 
-// Fornece a ordenação
-struct CFSKey
-{
-    double vruntime;
-    int pid;
+        int slot = next_slot();
+        Process &proc = slots[slot];
+        current_time += switch_costs.dispatch(proc.pid, current_time, verbose);
+        proc.mark_running(current_time);
 
-    bool operator<(const CFSKey &other) const
-    {
-        // compara os vruntimes
-        if (vruntime == other.vruntime)
-            return pid < other.pid; // Se os vruntimes são iguais, usa o PID como desempate
-        return vruntime < other.vruntime;
-    }
-};
+        int time_to_run = std::min(proc.remaining_time, quantum);
+        sync_to_wall_clock(current_time + time_to_run);
 
-// Classe do Escalonador CFS
-class CFSScheduler
-{
-private:
-    std::map<CFSKey, Process> run_queue; // fila processos -> usa a arvore da lib
-    std::queue<Process> arrival_queue;   // Fila de chegada
-    std::vector<Process> finished_processes;
-    int cpu_time = 0;
-    // define a quantidade de tempo que um processo pode rodar na cpu, apos isso ele muda -> IMPORTANTE Pode mudar mas olhe bem os arquivos nao coloque um número absurdo
-    const int TIME_SLICE;
-    // peso mínimo que um processo pode ter vai ser usado para o cálculo do vrtime
-    const int MIN_WEIGHT = 1;
+        if (verbose)
+        {
+            std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + time_to_run << "]: "
+                      << "Processo " << proc.pid << " esta na CPU. (Restante: "
+                      << proc.remaining_time - time_to_run << ")" << std::endl;
+        }
 
-public:
-    CFSScheduler(int time_slice) : TIME_SLICE(time_slice) {}
-    void load_processes(const FileReader &reader)
-    {
-        const auto &pids = reader.get_pids();
-        const auto &creation_times = reader.get_creation_times();
-        const auto &burst_times = reader.get_burst_times();
-        const auto &tickets = reader.get_ticket_values();
+        current_time += time_to_run;
+        proc.remaining_time -= time_to_run;
+        switch_costs.ran(proc.pid, time_to_run);
 
-        for (size_t i = 0; i < pids.size(); ++i)
+        if (sink)
         {
-            Process proc(pids[i], creation_times[i], burst_times[i], tickets[i]);
-            arrival_queue.push(proc);
+            int reason = (proc.remaining_time > 0) ? REASON_PREEMPT : (proc.has_io_next() ? REASON_BLOCK : REASON_FINISH);
+            sink->on_slice(current_time - time_to_run, current_time, proc.pid, reason);
         }
-    }
 
-    void run()
-    {
-        std::cout << "\n--- Iniciando Simulacao do Escalonador ---\n";
-        std::cout << "Algoritmo: CFS | Fatia de CPU: " << TIME_SLICE << "\n\n";
+        // Chegadas e retornos de E/S durante a fatia entram na fila antes do processo que acabou de rodar
+        drain_to_watermark();
+        wake_sleepers();
+        admit_pending();
 
-        while (!run_queue.empty() || !arrival_queue.empty())
+        Process &current = slots[slot]; // admit_pending pode ter realocado os slots
+        double vruntime = vruntimes[slot] + static_cast<double>(time_to_run) / current.weights;
+        if (current.remaining_time > 0)
         {
-            // mover processos para a fila de execução
-            while (!arrival_queue.empty() && arrival_queue.front().creation_time <= cpu_time)
+            enqueue_ready(slot, vruntime);
+            continue;
+        }
+        if (current.has_io_next())
+        {
+            vruntimes[slot] = vruntime; // fica congelado enquanto dorme
+            int wake_time = current.start_io(current_time);
+            sleeping.insert(wake_time, slot);
+            if (verbose)
             {
-                Process proc = arrival_queue.front();
-                arrival_queue.pop();
-                run_queue.insert({{0.0, proc.pid}, proc});
+                std::cout << ">>> Processo " << current.pid << " bloqueado em E/S ate o tempo " << wake_time << " <<<" << std::endl;
             }
+            continue;
+        }
 
-            if (run_queue.empty())
-            {
-                cpu_time++;
-                continue;
-            }
+        current.end_time = current_time;
+        current.is_finished = true;
+        statistics.append(current);
+        if (verbose)
+        {
+            std::cout << ">>> Processo " << current.pid << " finalizado no tempo " << current_time << " <<<" << std::endl;
+        }
+        if (verbose || current.deadline >= 0) // a tabela de prazos precisa dos processos com prazo
+        {
+            finished_processes.push_back(current);
+        }
 
-            auto it = run_queue.begin();
-            CFSKey key = it->first;
-            Process proc = it->second;
-            run_queue.erase(it);
+        Completion completion = {current.pid, current.creation_time, current.burst_time, current.end_time};
+        Backoff full;
+        while (!completions.try_push(completion)) // anel de conclusoes cheio: espera o consumidor
+        {
+            full.wait();
+        }
+        free_slots.push_back(slot);
+    }
 
-            int slice = std::min(TIME_SLICE, proc.remaining_time);
-            int start = cpu_time;
-            int end = cpu_time + slice;
+    if (verbose)
+    {
+        std::cout << "\n--- Simulacao finalizada no tempo " << current_time << " ---\n";
+    }
+    finished.store(true, std::memory_order_release);
+}
 
-            std::cout << "Tempo[" << std::setw(3) << start << " -> " << std::setw(3) << end << "]: Processo "
-                      << proc.pid << " esta na CPU. (Restante: " << (proc.remaining_time - slice) << ")\n";
+void OnlineScheduler::print_statistics(bool per_process)
+{
+    print_statistics_table(finished_processes, statistics, current_time, per_process, &switch_costs);
+}
 
-            if (proc.start_time == -1)
-                proc.start_time = cpu_time;
+// Dispara os produtores e o escalonador online e consome as conclusoes na thread principal
+void run_online(const FileReader &reader, const std::string &algorithm, int producer_count, int tick_us, bool verbose,
+                bool summary_only, const SwitchCostModel &switch_costs, EventSink *sink)
+{
+    MpscRing<Arrival> arrivals(1 << 16);
+    SpscRing<Completion> completions(1 << 16);
 
-            cpu_time += slice;
-            proc.remaining_time -= slice;
+    OnlineScheduler scheduler(algorithm, reader, producer_count, arrivals, completions);
+    scheduler.set_tick_us(tick_us);
+    scheduler.set_verbose(verbose);
+    scheduler.set_event_sink(sink);
+    scheduler.set_switch_cost_model(switch_costs);
 
-            // Calcula o novo vruntime baseado no tempo de execução do processo (slice).
-            // Fórmula: vruntime += (tempo_executado * MIN_WEIGHT) / peso_do_processo
-            // Quanto maior o peso (maior prioridade), mais lentamente o vruntime cresce,
-            // permitindo que o processo tenha mais tempo de CPU ao longo do tempo.
-            double new_vruntime = key.vruntime + (static_cast<double>(slice) * MIN_WEIGHT) / proc.weights;
+    const std::vector<int> &pids = reader.get_pids();
+    const std::vector<int> &creation_times = reader.get_creation_times();
+    const std::vector<int> &burst_times = reader.get_burst_times();
 
-            proc.total_waiting_time = cpu_time - proc.creation_time - (proc.burst_time - proc.remaining_time);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::thread scheduler_thread(&OnlineScheduler::run, &scheduler);
 
-            if (proc.remaining_time > 0)
+    // Cada produtor publica as linhas i, i + n, i + 2n, ... do arquivo
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p)
+    {
+        producers.emplace_back([&, p]()
+                               {
+            // Marca d'agua: menor criacao entre as linhas que ainda faltam publicar
+            // (as negativas sao carimbadas na drenagem e nao seguram o tempo)
+            size_t count = (pids.size() > static_cast<size_t>(p)) ? (pids.size() - p + producer_count - 1) / producer_count : 0;
+            std::vector<int> remaining_min(count + 1, std::numeric_limits<int>::max());
+            for (size_t k = count; k-- > 0;)
             {
-                run_queue.insert({{new_vruntime, proc.pid}, proc});
+                int creation_time = creation_times[p + k * producer_count];
+                remaining_min[k] = std::min(remaining_min[k + 1], creation_time < 0 ? std::numeric_limits<int>::max() : creation_time);
             }
-            else
+            scheduler.publish_progress(p, 0, remaining_min[0]);
+
+            for (size_t k = 0; k < count; ++k)
             {
-                proc.end_time = cpu_time;
-                proc.is_finished = true;
-                std::cout << ">>> Processo " << proc.pid << " finalizado no tempo " << cpu_time << " <<<\n";
-                finished_processes.push_back(proc);
-            }
+                size_t i = p + k * producer_count;
+                Arrival arrival = {pids[i], creation_times[i], burst_times[i], static_cast<int>(i)};
+                Backoff full;
+                while (!arrivals.try_push(arrival)) // anel cheio: o escalonador ainda nao drenou
+                {
+                    if (scheduler.is_finished()) // escalonador interrompido: ninguem mais vai drenar
+                        return;
+                    full.wait();
+                }
+                scheduler.publish_progress(p, static_cast<long long>(k + 1), remaining_min[k + 1]);
+            } });
+    }
+
+    // Os produtores sao aguardados em outra thread para que a principal continue consumindo conclusoes
+    std::thread closer([&]()
+                       {
+        for (auto &producer : producers)
+        {
+            producer.join();
         }
+        scheduler.close_arrivals(); });
 
-        std::cout << "\n--- Simulacao finalizada no tempo " << cpu_time << " ---\n\n";
-        print_statistics();
+    // A thread principal so consome o anel de conclusoes; as estatisticas ficam com o escalonador
+    long long finished_count = 0;
+    Completion completion;
+    Backoff backoff;
+    while (true)
+    {
+        bool scheduler_finished = scheduler.is_finished(); // lido antes do anel para nao perder a ultima conclusao
+        if (!completions.try_pop(completion))
+        {
+            if (scheduler_finished)
+            {
+                break;
+            }
+            backoff.wait();
+            continue;
+        }
+        backoff.reset();
+        finished_count++;
     }
+    closer.join();
+    scheduler_thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    scheduler.print_statistics(!summary_only && verbose);
+
+    std::cout << "\n--- Resumo do Modo Online ---\n";
+    std::cout << "Produtores: " << producer_count << " | Tick: " << tick_us << " us\n";
+    std::cout << "Chegadas ingeridas: " << scheduler.get_arrival_count() << " em " << std::fixed << std::setprecision(3) << seconds << " s ("
+              << std::setprecision(0) << (seconds > 0 ? scheduler.get_arrival_count() / seconds : 0.0) << " chegadas/s)\n";
+    std::cout << "Conclusoes consumidas: " << finished_count << "\n";
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+// Cache de resultados em disco: a saida de uma simulacao, os avisos e erros dela (e o trace, se
+// pedido) ficam guardados sob a chave hash(conteudo do arquivo + parametros + versao e hash do codigo)
+
+// Formato das entradas; mudar junto com CacheHeader ou com a ordem dos blocos
+const uint32_t CACHE_FORMAT_VERSION = 2;
 
-    void print_statistics()
+// Identidade do codigo na chave do cache: a versao do simulador mais o hash do main.cpp passado
+// na compilacao (-DSIMULATOR_SOURCE_HASH=<hex>, veja o README). Recompilar o mesmo codigo mantem
+// as chaves, entao builds repetidos (CI) reaproveitam o cache; sem o hash vale so a versao,
+// que precisa mudar sempre que a simulacao ou a saida mudarem.
+const uint32_t SIMULATOR_VERSION = 2;
+#define SIMULATOR_STRINGIFY_VALUE(x) #x
+#define SIMULATOR_STRINGIFY(x) SIMULATOR_STRINGIFY_VALUE(x)
+#ifdef SIMULATOR_SOURCE_HASH
+const char *const SIMULATOR_SOURCE = SIMULATOR_STRINGIFY(SIMULATOR_SOURCE_HASH);
+#else
+const char *const SIMULATOR_SOURCE = "";
+#endif
+
+// FNV-1a de 64 bits; hash continua a partir de um valor anterior para encadear varios blocos
+uint64_t fnv1a(const char *data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+    for (size_t i = 0; i < size; ++i)
     {
-        std::cout << "--- Estatisticas Finais ---\n";
-        std::cout << "PID       Tempo Total                 Tempo Pronto\n";
-        std::cout << "------------------------------------------------------------\n";
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 
-        for (const auto &proc : finished_processes)
-        {
-            int tempo_total = proc.end_time - proc.creation_time;
-            std::cout << std::left << std::setw(10) << proc.pid
-                      << std::setw(25) << tempo_total
-                      << proc.total_waiting_time << "\n";
-        }
+bool read_whole_file(const std::string &filename, std::string &contents)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
     }
-};
+    contents.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(&contents[0], contents.size());
+    return static_cast<bool>(file);
+}
 
-// Escalonador por Alternancia Circular
+struct CacheHeader // cabecalho de cada entrada; a saida, os erros e o trace vem logo depois
+{
+    char magic[8]; // "ESCCACHE"
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t key;
+    uint64_t output_size;
+    uint64_t errors_size; // o que a simulacao escreveu em std::cerr
+    uint64_t trace_size;
+    uint64_t checksum; // FNV-1a da saida seguida dos erros e do trace
+};
 
-class RoundRobinScheduler
+// Um arquivo por entrada (<chave>.res). A gravacao vai para um arquivo temporario renomeado no
+// final, entao uma entrada nunca e vista pela metade; entradas corrompidas ou de outra versao
+// sao apagadas na leitura. O mtime marca o ultimo uso e o diretorio e limitado por tamanho,
+// apagando as entradas usadas ha mais tempo (LRU).
+class ResultCache
 {
 public:
-    RoundRobinScheduler();
-    void set_algorithm_name(const std::string &name);
-    void set_quantum(int q);
-    void add_process(const Process &process);
-    void run();
-    void print_statistics();
+    ResultCache(const std::string &directory, uint64_t size_limit);
+    bool lookup(uint64_t key, std::string &output, std::string &errors, std::string &trace);
+    void store(uint64_t key, const std::string &output, const std::string &errors, const std::string &trace);
 
 private:
-    void update_ready_queue();
-    std::vector<Process> all_processes;
-    std::queue<Process *> ready_queue;
-    std::string algorithm_name;
-    int quantum;
-    int current_time;
-    size_t finished_process_count;
+    std::string path_for(uint64_t key) const;
+    void evict(); // apaga as entradas menos usadas ate caber no limite
+    std::string directory;
+    uint64_t size_limit;
 };
 
-RoundRobinScheduler::RoundRobinScheduler()
+ResultCache::ResultCache(const std::string &directory, uint64_t size_limit)
 {
-    quantum = 0;
-    current_time = 0;
-    finished_process_count = 0;
+    this->directory = directory;
+    this->size_limit = size_limit;
 }
 
-void RoundRobinScheduler::set_algorithm_name(const std::string &name) { algorithm_name = name; }
-void RoundRobinScheduler::set_quantum(int q) { quantum = q; }
-void RoundRobinScheduler::add_process(const Process &process) { all_processes.push_back(process); }
+std::string ResultCache::path_for(uint64_t key) const
+{
+    std::ostringstream path;
+    path << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".res";
+    return path.str();
+}
 
-void RoundRobinScheduler::update_ready_queue()
+bool ResultCache::lookup(uint64_t key, std::string &output, std::string &errors, std::string &trace)
 {
-    for (auto &process : all_processes)
+    std::string path = path_for(key);
+    std::string contents;
+    if (!read_whole_file(path, contents))
     {
-        if (!process.is_finished && process.creation_time <= current_time)
-        {
-            bool in_queue = false;
+        return false;
+    }
 
-            std::queue<Process *> temp_q = ready_queue;
-            while (!temp_q.empty())
-            {
-                if (temp_q.front()->get_pid() == process.get_pid())
-                {
-                    in_queue = true;
-                    break;
-                }
-                temp_q.pop();
-            }
-            if (process.start_time != -1)
-                in_queue = true;
+    CacheHeader header;
+    bool valid = contents.size() >= sizeof(header);
+    if (valid)
+    {
+        std::memcpy(&header, contents.data(), sizeof(header));
+        valid = std::memcmp(header.magic, "ESCCACHE", 8) == 0 && header.version == CACHE_FORMAT_VERSION && header.key == key &&
+                contents.size() == sizeof(header) + header.output_size + header.errors_size + header.trace_size &&
+                fnv1a(contents.data() + sizeof(header), contents.size() - sizeof(header)) == header.checksum;
+    }
+    if (!valid)
+    {
+        std::cerr << "Entrada invalida removida do cache: " << path << std::endl;
+        unlink(path.c_str());
+        return false;
+    }
 
-            if (!in_queue)
-            {
-                ready_queue.push(&process);
-            }
+    output.assign(contents, sizeof(header), header.output_size);
+    errors.assign(contents, sizeof(header) + header.output_size, header.errors_size);
+    trace.assign(contents, sizeof(header) + header.output_size + header.errors_size, std::string::npos);
+    utime(path.c_str(), nullptr); // marca o uso para o LRU
+    return true;
+}
+
+void ResultCache::store(uint64_t key, const std::string &output, const std::string &errors, const std::string &trace)
+{
+    std::string path = path_for(key);
+    std::string temp_path = path + ".tmp." + std::to_string(getpid());
+    mkdir(directory.c_str(), 0755); // se ja existir, mkdir apenas falha
+
+    uint64_t checksum = fnv1a(trace.data(), trace.size(), fnv1a(errors.data(), errors.size(), fnv1a(output.data(), output.size())));
+    CacheHeader header = {{'E', 'S', 'C', 'C', 'A', 'C', 'H', 'E'}, CACHE_FORMAT_VERSION, 0, key, output.size(), errors.size(), trace.size(), checksum};
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(output.data(), output.size());
+        file.write(errors.data(), errors.size());
+        file.write(trace.data(), trace.size());
+        if (!file)
+        {
+            std::cerr << "Erro ao gravar no cache: " << temp_path << std::endl;
+            file.close();
+            unlink(temp_path.c_str());
+            return;
         }
     }
+    if (rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "Erro ao gravar no cache: " << path << std::endl;
+        unlink(temp_path.c_str());
+        return;
+    }
+    evict();
 }
 
-void RoundRobinScheduler::run()
+void ResultCache::evict()
 {
-    std::cout << "--- Iniciando Simulacao do Escalonador ---\n";
-    std::cout << "Algoritmo: " << algorithm_name << " | Fatia de CPU: " << quantum << std::endl
-              << std::endl;
+    DIR *dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return;
+    }
+    struct Entry
+    {
+        std::string path;
+        long long last_use; // mtime em nanossegundos
+        uint64_t size;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    while (dirent *item = readdir(dir))
+    {
+        std::string name = item->d_name;
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".res") != 0)
+            continue;
+        std::string path = directory + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0)
+            continue;
+        entries.push_back({path, info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec, static_cast<uint64_t>(info.st_size)});
+        total += info.st_size;
+    }
+    closedir(dir);
 
-    while (finished_process_count < all_processes.size())
+    if (total <= size_limit)
     {
-        update_ready_queue();
+        return;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return a.last_use < b.last_use; });
+    for (size_t i = 0; i < entries.size() && total > size_limit; ++i)
+    {
+        unlink(entries[i].path.c_str());
+        total -= entries[i].size;
+    }
+}
 
-        if (ready_queue.empty())
-        {
-            current_time++;
-            continue;
-        }
+// Repassa tudo o que e escrito para o buffer original e guarda uma copia (ate um limite)
+class CaptureBuffer : public std::streambuf
+{
+public:
+    CaptureBuffer(std::streambuf *target, size_t limit) : target(target), limit(limit), overflowed(false) {}
+    const std::string &get_captured() const { return captured; }
+    bool is_complete() const { return !overflowed; } // false se a saida passou do limite e a copia foi abandonada
 
-        Process *current_proc = ready_queue.front();
-        ready_queue.pop();
+protected:
+    int overflow(int c) override
+    {
+        if (c == EOF)
+            return target->pubsync() == 0 ? 0 : EOF;
+        char ch = static_cast<char>(c);
+        keep(&ch, 1);
+        return target->sputc(ch);
+    }
+    std::streamsize xsputn(const char *s, std::streamsize n) override
+    {
+        keep(s, static_cast<size_t>(n));
+        return target->sputn(s, n);
+    }
+    int sync() override { return target->pubsync(); }
 
-        if (current_proc->start_time == -1)
+private:
+    void keep(const char *s, size_t n)
+    {
+        if (overflowed)
+            return;
+        if (captured.size() + n > limit)
         {
-            current_proc->start_time = current_time;
+            overflowed = true;
+            std::string().swap(captured);
+            return;
         }
+        captured.append(s, n);
+    }
+    std::streambuf *target;
+    size_t limit;
+    bool overflowed;
+    std::string captured;
+};
 
-        int time_to_run = std::min(current_proc->remaining_time, quantum);
-
-        std::cout << "Tempo[" << std::setw(3) << current_time << " -> " << std::setw(3) << current_time + time_to_run << "]: "
-                  << "Processo " << current_proc->get_pid() << " esta na CPU. (Restante: "
-                  << current_proc->remaining_time - time_to_run << ")" << std::endl;
+// Opcoes de linha de comando; sem argumentos o programa pergunta o nome do arquivo
+struct Options
+{
+    std::string filename;
+    bool online = false;   // --online: chegadas entram por threads produtoras
+    int tick_us = 0;       // --tick-us N: microssegundos reais por unidade de tempo (0 = o mais rapido possivel)
+    int producers = 4;     // --produtores N
+    bool verbose = true;   // --silencioso desliga o log de fatias
+    bool summary_only = false; // --resumo: estatisticas sem as linhas por processo
+    SwitchCostModel switch_costs; // --troca N, --penalidade-cache P, --penalidade-cache-tau T
+    bool has_seed = false;        // --semente N: sorteio reproduzivel da loteria
+    unsigned seed = 0;
+    std::string cache_dir;                      // --cache-resultados dir: reaproveita resultados de simulacoes identicas
+    uint64_t cache_limit = 256ULL << 20;        // --cache-limite MB
+    std::string trace_file;                        // --trace arquivo: grava o trace binario da simulacao
+    std::string export_input, export_output;       // --exportar-trace entrada saida: converte um trace para JSON
+    bool sweep = false;                            // --varredura: procura o melhor quantum
+    SweepOptions sweep_options;                    // --quantum A:B, --sementes A:B, --objetivo, --threads
+};
 
-        current_time += time_to_run;
-        current_proc->remaining_time -= time_to_run;
+// Le um intervalo "A:B" (ou apenas "A")
+void parse_range(const std::string &text, long long &low, long long &high)
+{
+    size_t colon = text.find(':');
+    low = std::stoll(text.substr(0, colon));
+    high = (colon == std::string::npos) ? low : std::stoll(text.substr(colon + 1));
+}
 
-        update_ready_queue();
+bool parse_options(int argc, char *argv[], Options &options)
+{
+    bool sweep_option = false; // --quantum, --sementes, --objetivo e --threads so fazem sentido na varredura
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
 
-        if (current_proc->remaining_time > 0)
+        if (arg == "--online")
+            options.online = true;
+        else if (arg == "--silencioso")
+            options.verbose = false;
+        else if (arg == "--resumo")
+            options.summary_only = true;
+        else if (arg == "--troca" && has_value)
+            options.switch_costs.switch_cost = std::stoi(argv[++i]);
+        else if (arg == "--penalidade-cache" && has_value)
+            options.switch_costs.cache_penalty = std::stoi(argv[++i]);
+        else if (arg == "--penalidade-cache-tau" && has_value)
+            options.switch_costs.cache_decay = std::stod(argv[++i]);
+        else if (arg == "--semente" && has_value)
         {
-            ready_queue.push(current_proc);
+            options.has_seed = true;
+            options.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--cache-resultados" && has_value)
+            options.cache_dir = argv[++i];
+        else if (arg == "--cache-limite" && has_value)
+            options.cache_limit = std::stoull(argv[++i]) << 20;
+        else if (arg == "--tick-us" && has_value)
+            options.tick_us = std::stoi(argv[++i]);
+        else if (arg == "--produtores" && has_value)
+            options.producers = std::stoi(argv[++i]);
+        else if (arg == "--trace" && has_value)
+            options.trace_file = argv[++i];
+        else if (arg == "--varredura")
+            options.sweep = true;
+        else if (arg == "--quantum" && has_value)
+        {
+            sweep_option = true;
+            long long low, high;
+            parse_range(argv[++i], low, high);
+            options.sweep_options.quantum_min = static_cast<int>(low);
+            options.sweep_options.quantum_max = static_cast<int>(high);
+        }
+        else if (arg == "--sementes" && has_value)
+        {
+            sweep_option = true;
+            long long low, high;
+            parse_range(argv[++i], low, high);
+            options.sweep_options.seed_min = static_cast<unsigned>(low);
+            options.sweep_options.seed_max = static_cast<unsigned>(high);
+        }
+        else if (arg == "--objetivo" && has_value)
+        {
+            sweep_option = true;
+            std::string objective = argv[++i];
+            if (objective == "turnaround")
+                options.sweep_options.objective = OBJECTIVE_TURNAROUND;
+            else if (objective == "p99")
+                options.sweep_options.objective = OBJECTIVE_P99_WAITING;
+            else if (objective == "trocas")
+                options.sweep_options.objective = OBJECTIVE_SWITCHES;
+            else if (objective == "vazao")
+                options.sweep_options.objective = OBJECTIVE_MAKESPAN;
+            else
+            {
+                std::cerr << "Objetivo invalido: " << objective << " (use turnaround, p99, trocas ou vazao)" << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--threads" && has_value)
+        {
+            sweep_option = true;
+            options.sweep_options.threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--exportar-trace" && i + 2 < argc)
+        {
+            options.export_input = argv[++i];
+            options.export_output = argv[++i];
         }
+        else if (arg.compare(0, 2, "--") != 0 && options.filename.empty())
+            options.filename = arg;
         else
         {
-            current_proc->end_time = current_time;
-            current_proc->is_finished = true;
-            finished_process_count++;
-            std::cout << ">>> Processo " << current_proc->get_pid() << " finalizado no tempo " << current_time << " <<<" << std::endl;
+            std::cerr << "Opcao invalida: " << arg << std::endl;
+            return false;
         }
     }
+    if (sweep_option && !options.sweep)
+    {
+        std::cerr << "--quantum, --sementes, --objetivo e --threads so valem com --varredura" << std::endl;
+        return false;
+    }
+    if (options.sweep && (options.online || !options.trace_file.empty()))
+    {
+        std::cerr << "--varredura nao pode ser combinada com --online nem com --trace" << std::endl;
+        return false;
+    }
+    if (options.tick_us < 0 || options.producers < 1)
+    {
+        std::cerr << "Valores invalidos para --tick-us ou --produtores" << std::endl;
+        return false;
+    }
+    if (options.switch_costs.switch_cost < 0 || options.switch_costs.cache_penalty < 0 || options.switch_costs.cache_decay < 0)
+    {
+        std::cerr << "Valores invalidos para --troca, --penalidade-cache ou --penalidade-cache-tau" << std::endl;
+        return false;
+    }
+    options.sweep_options.switch_costs = options.switch_costs;
+    const SweepOptions &sweep = options.sweep_options;
+    if (sweep.quantum_min < 1 || sweep.quantum_max < 0 || (sweep.quantum_max > 0 && sweep.quantum_max < sweep.quantum_min) || sweep.seed_max < sweep.seed_min)
+    {
+        std::cerr << "Intervalo invalido para --quantum ou --sementes" << std::endl;
+        return false;
+    }
+    return true;
+}
 
-    std::cout << "\n--- Simulacao finalizada no tempo " << current_time << " ---\n";
+// Chave do cache: conteudo do arquivo (que ja inclui algoritmo e quantum), identidade do codigo
+// do simulador e tudo que muda a saida
+uint64_t result_cache_key(const std::string &contents, const std::string &algorithm, const Options &options)
+{
+    std::ostringstream params;
+    params << CACHE_FORMAT_VERSION << '|' << SIMULATOR_VERSION << '|' << SIMULATOR_SOURCE << '|' << options.verbose << '|' << options.summary_only << '|'
+           << options.switch_costs.switch_cost << '|' << options.switch_costs.cache_penalty << '|'
+           << std::setprecision(17) << options.switch_costs.cache_decay << '|' << !options.trace_file.empty();
+    if (algorithm == "loteria")
+    {
+        params << '|' << options.seed;
+    }
+    std::string text = params.str();
+    return fnv1a(text.data(), text.size(), fnv1a(contents.data(), contents.size()));
 }
 
-void RoundRobinScheduler::print_statistics()
+int main(int argc, char *argv[])
 {
-    std::cout << "\n--- Estatisticas Finais ---\n";
-    std::cout << std::left << std::setw(10) << "PID"
-              << std::setw(25) << "Tempo Total"
-              << std::setw(25) << "Tempo Pronto" << std::endl;
-    std::cout << "------------------------------------------------------------\n";
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        return 1;
+    }
 
-    for (const auto &process : all_processes)
+    if (!options.export_input.empty())
     {
-        int turnaround_time = process.get_end_time() - process.get_creation_time();
-        int waiting_time = turnaround_time - process.burst_time;
+        return export_chrome_trace(options.export_input, options.export_output) ? 0 : 1;
+    }
 
-        std::cout << std::left << std::setw(10) << process.get_pid()
-                  << std::setw(25) << turnaround_time
-                  << std::setw(25) << waiting_time << std::endl;
+    std::string filename = options.filename;
+    if (filename.empty())
+    {
+        std::cout << "Digite o nome do arquivo de entrada: ";
+        std::cin >> filename;
     }
-}
 
-int main()
-{
-    std::cout << "Digite o nome do arquivo de entrada: ";
-    std::string filename;
-    std::cin >> filename;
+    // Com o cache ligado, um resultado ja conhecido e devolvido sem ler os processos nem simular.
+    // Sem semente fixa a loteria nao e reproduzivel, entao nao usa o cache.
+    const size_t CACHE_OUTPUT_LIMIT = 64 << 20; // saidas maiores nao sao guardadas
+    ResultCache result_cache(options.cache_dir, options.cache_limit);
+    bool use_cache = false;
+    uint64_t cache_key = 0;
+    std::string contents;
+    if (!options.cache_dir.empty() && !options.online && !options.sweep && read_whole_file(filename, contents))
+    {
+        std::string algorithm = contents.substr(0, contents.find('|'));
+        for (char &c : algorithm)
+        {
+            c = std::tolower(static_cast<unsigned char>(c));
+        }
+        use_cache = (algorithm != "loteria" || options.has_seed);
+        cache_key = result_cache_key(contents, algorithm, options);
+
+        std::string output, errors, trace_data;
+        if (use_cache && result_cache.lookup(cache_key, output, errors, trace_data))
+        {
+            if (!options.trace_file.empty())
+            {
+                std::ofstream trace_file(options.trace_file, std::ios::binary | std::ios::trunc);
+                trace_file.write(trace_data.data(), trace_data.size());
+            }
+            std::cerr << errors; // os avisos vem da leitura, antes da saida da simulacao
+            std::cout << output;
+            return 0;
+        }
+    }
+
+    // Com o cache ligado, a saida e os erros (inclusive os avisos da leitura) sao copiados para a entrada
+    CaptureBuffer output_capture(std::cout.rdbuf(), CACHE_OUTPUT_LIMIT);
+    CaptureBuffer error_capture(std::cerr.rdbuf(), CACHE_OUTPUT_LIMIT);
+    std::streambuf *original_output = nullptr;
+    std::streambuf *original_error = nullptr;
+    if (use_cache)
+    {
+        original_output = std::cout.rdbuf(&output_capture);
+        original_error = std::cerr.rdbuf(&error_capture);
+    }
+    auto release_streams = [&]()
+    {
+        if (use_cache)
+        {
+            std::cout.flush();
+            std::cout.rdbuf(original_output);
+            std::cerr.rdbuf(original_error);
+        }
+    };
 
     FileReader file_reader(filename);
     file_reader.read_file();
@@ -798,72 +4148,76 @@ int main()
         c = std::tolower(static_cast<unsigned char>(c));
     }
 
-    if (algorithm == "loteria")
+    TraceWriter trace_writer;
+    TraceWriter *trace = nullptr;
+    if (!options.trace_file.empty())
     {
-        LotteryScheduler scheduler;
-        scheduler.set_algorithm_name(file_reader.get_algorithm());
-        scheduler.set_quantum(file_reader.get_quantum());
-
-        const std::vector<int> &pids = file_reader.get_pids();
-        const std::vector<int> &creation_times = file_reader.get_creation_times();
-        const std::vector<int> &burst_times = file_reader.get_burst_times();
-        const std::vector<int> &ticket_values = file_reader.get_ticket_values();
-
-        for (size_t i = 0; i < pids.size(); ++i)
+        if (!trace_writer.open(options.trace_file))
         {
-            Process process(pids[i], creation_times[i], burst_times[i], ticket_values[i]);
-            scheduler.add_process(process);
+            release_streams();
+            return 1;
         }
-
-        scheduler.run();
-        scheduler.print_statistics();
+        trace = &trace_writer;
     }
-    else if (algorithm == "prioridade")
-    {
-        PriorityScheduler scheduler(file_reader.get_quantum());
 
-        const std::vector<int> &pids = file_reader.get_pids();
-        const std::vector<int> &creation_times = file_reader.get_creation_times();
-        const std::vector<int> &burst_times = file_reader.get_burst_times();
-        const std::vector<int> &ticket_values = file_reader.get_ticket_values();
-
-        for (size_t i = 0; i < pids.size(); ++i)
+    if (options.online)
+    {
+        if (algorithm != "cfs" && algorithm != "alternanciacircular")
         {
-            scheduler.addProcess(pids[i], creation_times[i], burst_times[i], ticket_values[i]);
+            std::cerr << "Modo online suporta apenas cfs e alternanciacircular.\n";
+            return 1;
         }
-        scheduler.run();
+        const auto &process_groups = file_reader.get_process_groups();
+        bool has_groups = !file_reader.get_group_names().empty();
+        for (const auto &group : process_groups)
+        {
+            has_groups = has_groups || !group.empty();
+        }
+        if (has_groups) // o escalonador online nao tem a hierarquia de grupos do CFS
+        {
+            std::cerr << "Modo online nao suporta grupos (grupo=).\n";
+            return 1;
+        }
+        run_online(file_reader, algorithm, options.producers, options.tick_us, options.verbose, options.summary_only, options.switch_costs, trace);
     }
-    else if (algorithm == "cfs")
+    else if (options.sweep)
     {
-        CFSScheduler scheduler(file_reader.get_quantum());
-        scheduler.load_processes(file_reader);
-        scheduler.run();
+        if (!is_supported_algorithm(algorithm))
+        {
+            std::cerr << "Algoritmo não suportado ou ainda não implementado.\n";
+            return 1;
+        }
+        run_sweep(file_reader, algorithm, options.sweep_options);
     }
-    else if (algorithm == "alternanciacircular")
+    else
     {
-        RoundRobinScheduler scheduler;
-        scheduler.set_algorithm_name(file_reader.get_algorithm());
-        scheduler.set_quantum(file_reader.get_quantum());
+        SimulationConfig config;
+        config.quantum = file_reader.get_quantum();
+        config.sink = trace;
+        config.verbose = options.verbose;
+        config.per_process_statistics = !options.summary_only;
+        config.switch_costs = options.switch_costs;
+        config.has_seed = options.has_seed;
+        config.seed = options.seed;
 
-        const std::vector<int> &pids = file_reader.get_pids();
-        const std::vector<int> &creation_times = file_reader.get_creation_times();
-        const std::vector<int> &burst_times = file_reader.get_burst_times();
-        const std::vector<int> &ticket_values = file_reader.get_ticket_values();
+        bool simulated = run_simulation(file_reader, algorithm, config);
+        release_streams();
 
-        for (size_t i = 0; i < pids.size(); ++i)
+        if (!simulated)
         {
-            Process process(pids[i], creation_times[i], burst_times[i], ticket_values[i]);
-            scheduler.add_process(process);
+            std::cerr << "Algoritmo não suportado ou ainda não implementado.\n";
+        }
+        else if (use_cache && output_capture.is_complete() && error_capture.is_complete() && (!trace || trace_writer.is_complete()))
+        {
+            std::string trace_data;
+            if (trace)
+            {
+                trace_writer.close();
+                read_whole_file(options.trace_file, trace_data);
+            }
+            result_cache.store(cache_key, output_capture.get_captured(), error_capture.get_captured(), trace_data);
         }
-
-        scheduler.run();
-        scheduler.print_statistics();
-    }
-
-    else
-    {
-        std::cerr << "Algoritmo não suportado ou ainda não implementado.\n";
     }
 
-    return 0;
+    return (trace && !trace_writer.is_complete()) ? 1 : 0; // trace incompleto e erro
 }
\ No newline at end of file